@@ -0,0 +1,111 @@
+// Include library source first to reach internal parsers, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+#include <time.h>
+
+// Define number of values in each corpus
+#define VALUES 10000000
+
+typedef struct corpus
+{
+    const char *name;
+    const char *shape; // Format of each value
+    int precision;     // Significant digits or digits after point
+} corpus;
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Return pseudo-random double in [-1e6, 1e6] with random scale
+static double random_double(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    double unit = (double)(*state >> 11) / 9007199254740992.0;
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unit * 2 - 1) * pow(10, (double)(*state >> 33) / 4294967296.0 * 12 - 6);
+}
+
+// Convert string like previous get_double function with strtod(3)
+static bool libc_double(const char *str, size_t size, double *value)
+{
+    while (isspace((unsigned char)*str))
+        str++;
+    if (*str == '\0')
+        return false;
+
+    errno = 0;
+    char *end;
+    *value = strtod(str, &end);
+    while (isspace((unsigned char)*end))
+        end++;
+    return errno == 0 && *end == '\0' && isfinite(*value) && *value >= -DBL_MAX && *value <= DBL_MAX;
+}
+
+// Convert string with parser of get_double function
+static bool library_double(const char *str, size_t size, double *value)
+{
+    return parse_double(&input, str, size, value) == INPUT_OK;
+}
+
+// Parse every value of corpus and return nanoseconds per value
+static double measure(bool (*parse)(const char *, size_t, double *), const char *text, const size_t *offsets, double *sum)
+{
+    double start = now();
+    for (size_t i = 0; i < VALUES; i++)
+    {
+        double val;
+        if (!parse(text + offsets[i], offsets[i + 1] - offsets[i] - 1, &val))
+        {
+            fprintf(stderr, "Error: rejected \"%s\"\n", text + offsets[i]);
+            exit(2);
+        }
+        *sum += val;
+    }
+    return (now() - start) * 1e9 / VALUES;
+}
+
+int main(void)
+{
+    corpus corpora[] = {
+        {"fixed6", "%.*f", 6},  // Measurements like 123.456789
+        {"general", "%.*g", 10}, // Mixed notation like 1.234567891e-05
+        {"exact17", "%.*g", 17}, // Shortest round-trip digits of random doubles
+    };
+
+    size_t *offsets = malloc(sizeof(size_t) * (VALUES + 1));
+    char *text = malloc((size_t)VALUES * 32);
+    if (offsets == NULL || text == NULL)
+        return 1;
+
+    printf("%-8s %-8s %10s %10s\n", "corpus", "parser", "ns/value", "MB/s");
+    for (size_t c = 0; c < sizeof(corpora) / sizeof(corpora[0]); c++)
+    {
+        // Generate values terminated by '\0', with offsets of each value
+        uint64_t state = 1;
+        size_t size = 0;
+        for (size_t i = 0; i < VALUES; i++)
+        {
+            offsets[i] = size;
+            size += snprintf(text + size, 32, corpora[c].shape, corpora[c].precision, random_double(&state)) + 1;
+        }
+        offsets[VALUES] = size;
+
+        double sum = 0;
+        double libc = measure(libc_double, text, offsets, &sum);
+        double library = measure(library_double, text, offsets, &sum);
+
+        printf("%-8s %-8s %10.1f %10.1f\n", corpora[c].name, "strtod", libc, size / (libc * VALUES / 1e3));
+        printf("%-8s %-8s %10.1f %10.1f\n", corpora[c].name, "library", library, size / (library * VALUES / 1e3));
+        if (sum == 0.5) // Keep sum observable
+            printf("\n");
+    }
+
+    free(text);
+    free(offsets);
+    return 0;
+}
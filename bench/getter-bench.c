@@ -0,0 +1,482 @@
+// Enable POSIX functions for pipes and children
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "../src/stdprompt.h"
+
+// Define size of each generated corpus, number of timed passes, and strings kept in arena before reset
+#define CORPUS_SIZE (8 << 20)
+#define PASSES 3
+#define ARENA_STRINGS 4096
+
+// Count calls to allocator and reallocations, interposed over glibc allocator so calls from static and shared library are counted alike
+static size_t allocations = 0;
+static size_t reallocations = 0;
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    allocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocations++;
+    reallocations++;
+    return __libc_realloc(ptr, size);
+}
+
+// Define generator of corpus, writing one record of lines
+typedef void (*generator)(FILE *file, unsigned long *state);
+
+// Define function reading every value of stream, returning number of values read
+typedef size_t (*runner)(stream *s);
+
+// Define benchmark case of getter on corpus
+typedef struct bench_case
+{
+    const char *corpus; // Name of corpus
+    generator generate; // Generator of corpus
+    const char *getter; // Name of getter
+    runner run;         // Function reading corpus with getter
+} bench_case;
+
+// Prevent compiler from discarding values read
+static volatile long double sink;
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Write short non-negative int, like counts typed by user, so unsigned getters read every value too
+static void short_int(FILE *file, unsigned long *state)
+{
+    fprintf(file, "%lu\n", next(state) % 200000);
+}
+
+// Write short int with CRLF (\r\n) line ending, like file from Windows
+static void crlf_int(FILE *file, unsigned long *state)
+{
+    fprintf(file, "%ld\r\n", (long)(next(state) % 200000) - 100000);
+}
+
+// Write double in scientific notation with 17 significant digits, mostly beyond exact fast path
+static void scientific(FILE *file, unsigned long *state)
+{
+    fprintf(file, "%.16e\n", (double)next(state) / (double)(1 + next(state) % 1000000) * 1e-3);
+}
+
+// Write line of 4 KiB to 256 KiB of letters
+static void long_line(FILE *file, unsigned long *state)
+{
+    for (size_t n = 4096 + next(state) % (252 << 10); n > 0; n--)
+        fputc('a' + n % 26, file);
+    fputc('\n', file);
+}
+
+// Write three rejected lines before each int, so typed getters retry
+static void garbage(FILE *file, unsigned long *state)
+{
+    static const char *rejected[] = {"x", "", "12a", " - ", "1.5", "99999999999999999999", "\t"};
+    for (int i = 0; i < 3; i++)
+        fprintf(file, "%s\n", rejected[next(state) % (sizeof(rejected) / sizeof(rejected[0]))]);
+    fprintf(file, "%ld\n", (long)(next(state) % 2000) - 1000);
+}
+
+// Write single character surrounded by optional whitespace
+static void character(FILE *file, unsigned long *state)
+{
+    fprintf(file, next(state) % 4 ? "%c\n" : " %c \n", (int)('!' + next(state) % 94));
+}
+
+// Write application log line with timestamp, level, component, and message of varying length
+static void log_line(FILE *file, unsigned long *state)
+{
+    static const char *levels[] = {"DEBUG", "INFO", "INFO", "INFO", "WARN", "ERROR"};
+    static const char *components[] = {"http", "db.pool", "scheduler", "auth", "cache"};
+    static const char *words[] = {"request", "completed", "in", "ms", "for", "user", "session", "expired",
+                                  "retrying", "connection", "timeout", "queued", "id", "upstream", "closed"};
+
+    unsigned long t = next(state);
+    fprintf(file, "2024-05-%02lu %02lu:%02lu:%02lu.%03lu %-5s [%s]", 1 + t % 28, t / 28 % 24, t / 672 % 60, t / 40320 % 60,
+            next(state) % 1000, levels[next(state) % 6], components[next(state) % 5]);
+    for (unsigned long n = 2 + next(state) % 16; n > 0; n--)
+        fprintf(file, " %s", words[next(state) % 15]);
+    fprintf(file, " %lu\n", next(state));
+}
+
+// Write CSV row of id, name, city, price, quantity, and date
+static void csv_row(FILE *file, unsigned long *state)
+{
+    static const char *names[] = {"Ada", "Grace", "Linus", "Barbara", "Ken", "Margaret", "Dennis", "Frances"};
+    static const char *cities[] = {"Oslo", "Lisbon", "Krakow", "San Francisco", "Buenos Aires", "Kyoto", "Nairobi"};
+
+    fprintf(file, "%lu,%s %s,%s,%lu.%02lu,%lu,2024-%02lu-%02lu\n", next(state), names[next(state) % 8], names[next(state) % 8],
+            cities[next(state) % 7], next(state) % 10000, next(state) % 100, next(state) % 500, 1 + next(state) % 12,
+            1 + next(state) % 28);
+}
+
+// Define runner of typed getter, counting values until sentinel value at EOF
+#define TYPED(name, type, getter, sentinel)                        \
+    static size_t name(stream *s)                                  \
+    {                                                              \
+        size_t n = 0;                                              \
+        while (true)                                               \
+        {                                                          \
+            type val = getter(s, NULL);                            \
+            if (val == sentinel && get_status() != INPUT_OK)       \
+                return n;                                          \
+            sink = val;                                            \
+            n++;                                                   \
+        }                                                          \
+    }
+
+TYPED(run_char, char, get_char_from, CHAR_MAX)
+TYPED(run_unsigned_char, unsigned char, get_unsigned_char_from, UCHAR_MAX)
+TYPED(run_int, int, get_int_from, INT_MAX)
+TYPED(run_unsigned_int, unsigned int, get_unsigned_int_from, UINT_MAX)
+TYPED(run_long, long, get_long_from, LONG_MAX)
+TYPED(run_unsigned_long, unsigned long, get_unsigned_long_from, ULONG_MAX)
+TYPED(run_long_long, long long, get_long_long_from, LLONG_MAX)
+TYPED(run_unsigned_long_long, unsigned long long, get_unsigned_long_long_from, ULLONG_MAX)
+TYPED(run_float, float, get_float_from, FLT_MAX)
+TYPED(run_double, double, get_double_from, DBL_MAX)
+TYPED(run_long_double, long double, get_long_double_from, LDBL_MAX)
+
+// Read every line into string on heap, freeing each string
+static size_t run_string(stream *s)
+{
+    size_t n = 0;
+    for (char *str; (str = get_string_from(s, NULL)) != NULL; n++)
+    {
+        sink = str[0];
+        free_string(str);
+    }
+    return n;
+}
+
+// Read every line into string on heap, keeping every string until rollback to mark
+static size_t run_kept(stream *s)
+{
+    size_t mark = checkpoint_strings();
+    size_t n = 0;
+    for (char *str; (str = get_string_from(s, NULL)) != NULL; n++)
+        sink = str[0];
+    rollback_strings(mark);
+    return n;
+}
+
+// Read every line into string in arena, resetting arena after batch of strings
+static size_t run_arena(stream *s)
+{
+    arena *a = create_arena();
+    use_arena(a);
+    size_t n = 0;
+    for (char *str; (str = get_string_from(s, NULL)) != NULL; n++)
+    {
+        sink = str[0];
+        if (n % ARENA_STRINGS == ARENA_STRINGS - 1)
+            reset_arena(a);
+    }
+    use_arena(NULL);
+    destroy_arena(a);
+    return n;
+}
+
+// View every line without copying
+static size_t run_view(stream *s)
+{
+    size_t n = 0;
+    for (line_view line; (line = get_line_view_from(s, NULL)).data != NULL; n++)
+        sink = line.size;
+    return n;
+}
+
+// Count pieces of lines passed by get_line_chunks function
+static void count_piece(void *context, const char *data, size_t size, bool last)
+{
+    sink = size;
+}
+
+// Pass every line in pieces of 64 KiB
+static size_t run_chunks(stream *s)
+{
+    size_t n = 0;
+    while (get_line_chunks(s, 65536, count_piece, NULL, NULL) == INPUT_OK)
+        n++;
+    return n;
+}
+
+// Parse every line once with try_get_int function, counting rejected lines as values
+static size_t run_try_int(stream *s)
+{
+    size_t n = 0;
+    for (int val; try_get_int(s, &val, NULL) != INPUT_EOF; n++)
+        sink = val;
+    return n;
+}
+
+// Parse every line once with try_get_double function, counting rejected lines as values
+static size_t run_try_double(stream *s)
+{
+    size_t n = 0;
+    for (double val; try_get_double(s, &val, NULL) != INPUT_EOF; n++)
+        sink = val;
+    return n;
+}
+
+// Read ints in arrays of 64 values
+static size_t run_int_array(stream *s)
+{
+    int values[64];
+    size_t n = 0, count;
+    do
+    {
+        count = 64;
+        if (get_int_array_from(s, values, &count, NULL, NULL) == NULL)
+            break;
+        sink = values[0];
+        n += count;
+    } while (count == 64);
+    return n;
+}
+
+// Read doubles in arrays of 64 values
+static size_t run_double_array(stream *s)
+{
+    double values[64];
+    size_t n = 0, count;
+    do
+    {
+        count = 64;
+        if (get_double_array_from(s, values, &count, NULL, NULL) == NULL)
+            break;
+        sink = values[0];
+        n += count;
+    } while (count == 64);
+    return n;
+}
+
+// Load every line with load_doubles function on one thread
+static size_t run_load_doubles(stream *s)
+{
+    size_t count = 0;
+    double *values = load_doubles(s, &count, NULL, NULL, 1);
+    if (values != NULL)
+        sink = values[0];
+    free(values);
+    return count;
+}
+
+// Define every getter against every corpus it reads
+static const bench_case cases[] = {
+    {"short_ints", short_int, "int", run_int},
+    {"short_ints", short_int, "unsigned_int", run_unsigned_int},
+    {"short_ints", short_int, "long", run_long},
+    {"short_ints", short_int, "unsigned_long", run_unsigned_long},
+    {"short_ints", short_int, "long_long", run_long_long},
+    {"short_ints", short_int, "unsigned_long_long", run_unsigned_long_long},
+    {"short_ints", short_int, "float", run_float},
+    {"short_ints", short_int, "double", run_double},
+    {"short_ints", short_int, "long_double", run_long_double},
+    {"short_ints", short_int, "try_int", run_try_int},
+    {"short_ints", short_int, "int_array", run_int_array},
+    {"short_ints", short_int, "string", run_string},
+    {"short_ints", short_int, "kept_string", run_kept},
+    {"short_ints", short_int, "arena", run_arena},
+    {"short_ints", short_int, "line_view", run_view},
+    {"crlf_ints", crlf_int, "int", run_int},
+    {"crlf_ints", crlf_int, "string", run_string},
+    {"crlf_ints", crlf_int, "line_view", run_view},
+    {"scientific", scientific, "float", run_float},
+    {"scientific", scientific, "double", run_double},
+    {"scientific", scientific, "long_double", run_long_double},
+    {"scientific", scientific, "try_double", run_try_double},
+    {"scientific", scientific, "double_array", run_double_array},
+    {"scientific", scientific, "load_doubles", run_load_doubles},
+    {"scientific", scientific, "line_view", run_view},
+    {"long_lines", long_line, "string", run_string},
+    {"long_lines", long_line, "arena", run_arena},
+    {"long_lines", long_line, "line_view", run_view},
+    {"long_lines", long_line, "line_chunks", run_chunks},
+    {"log_lines", log_line, "string", run_string},
+    {"log_lines", log_line, "line_view", run_view},
+    {"csv_rows", csv_row, "string", run_string},
+    {"csv_rows", csv_row, "kept_string", run_kept},
+    {"csv_rows", csv_row, "line_view", run_view},
+    {"garbage", garbage, "int", run_int},
+    {"garbage", garbage, "double", run_double},
+    {"garbage", garbage, "try_int", run_try_int},
+    {"characters", character, "char", run_char},
+    {"characters", character, "unsigned_char", run_unsigned_char},
+    {"characters", character, "string", run_string},
+    {"characters", character, "kept_string", run_kept},
+};
+
+// Define result of benchmark case
+typedef struct result
+{
+    size_t values;        // Number of values read in one pass
+    size_t bytes;         // Number of bytes of corpus
+    double seconds;       // Fastest pass
+    double allocations;   // Calls to allocator per value in last pass
+    double reallocations; // Reallocations per value in last pass
+} result;
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Generate corpus of about CORPUS_SIZE bytes from fixed seed, so every run reads same bytes
+static char *corpus(generator generate, size_t *size)
+{
+    char *text;
+    FILE *file = open_memstream(&text, size);
+    if (file == NULL)
+        return NULL;
+
+    unsigned long state = 1;
+    while (ftell(file) < CORPUS_SIZE)
+        generate(file, &state);
+    return fclose(file) == 0 ? text : NULL;
+}
+
+// Run case on fresh memory stream of corpus for each pass, keeping fastest pass
+static bool measure(const bench_case *c, result *r)
+{
+    char *text = corpus(c->generate, &r->bytes);
+    if (text == NULL)
+        return false;
+
+    r->seconds = 0;
+    for (int pass = 0; pass < PASSES; pass++)
+    {
+        stream *s = create_memory_stream(text, r->bytes);
+        if (s == NULL)
+            return false;
+
+        size_t before = allocations, resized = reallocations;
+        double start = now();
+        r->values = c->run(s);
+        double elapsed = now() - start;
+        r->allocations = r->values > 0 ? (double)(allocations - before) / r->values : 0;
+        r->reallocations = r->values > 0 ? (double)(reallocations - resized) / r->values : 0;
+        destroy_stream(s);
+
+        if (pass == 0 || elapsed < r->seconds)
+            r->seconds = elapsed;
+    }
+
+    free(text);
+    return r->values > 0;
+}
+
+// Return nanoseconds per value of case in baseline output, or 0 if case is missing
+static double baseline(FILE *file, const bench_case *c)
+{
+    if (file == NULL)
+        return 0;
+
+    rewind(file);
+    char line[256], corpus_name[64], getter[64];
+    double ns;
+    while (fgets(line, sizeof(line), file) != NULL)
+        if (sscanf(line, "%63s %63s %*s %*s %lf", corpus_name, getter, &ns) == 3 &&
+            !strcmp(corpus_name, c->corpus) && !strcmp(getter, c->getter))
+            return ns;
+    return 0;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc > 2)
+    {
+        fprintf(stderr, "\nUsage: %s [baseline]\n", argv[0]);
+        fprintf(stderr, "Run every getter against generated corpora, writing tab-separated results to standard output.\n");
+        fprintf(stderr, "Compare nanoseconds per value against baseline output of earlier run if given.\n\n");
+        return 1;
+    }
+
+    FILE *file = argc == 2 ? fopen(argv[1], "r") : NULL;
+    if (argc == 2 && file == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    printf("corpus\tgetter\tvalues\tbytes\tns_per_value\tmb_per_s\tallocs_per_value\treallocs_per_value\tpeak_rss_kib%s\n", file ? "\tratio" : "");
+    fflush(stdout);
+
+    // Run each case in child process, so peak resident set size is its own
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const bench_case *c = &cases[i];
+        int fds[2];
+        if (pipe(fds))
+            return 2;
+
+        pid_t pid = fork();
+        if (pid < 0)
+            return 2;
+        if (pid == 0)
+        {
+            result r;
+            bool ok = measure(c, &r);
+            ok = ok && write(fds[1], &r, sizeof(r)) == sizeof(r);
+            exit(ok ? 0 : 2); // Flush profile of instrumented library
+        }
+
+        close(fds[1]);
+        result r;
+        bool ok = read(fds[0], &r, sizeof(r)) == sizeof(r);
+        close(fds[0]);
+
+        int status;
+        struct rusage usage;
+        if (wait4(pid, &status, 0, &usage) < 0 || !ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            fprintf(stderr, "%s: %s: %s failed\n", argv[0], c->corpus, c->getter);
+            return 2;
+        }
+
+        double ns = r.seconds * 1e9 / r.values;
+        printf("%s\t%s\t%zu\t%zu\t%.2f\t%.1f\t%.3f\t%.3f\t%ld", c->corpus, c->getter, r.values, r.bytes, ns,
+               r.bytes / r.seconds / 1e6, r.allocations, r.reallocations, usage.ru_maxrss);
+        double before = baseline(file, c);
+        if (file != NULL)
+            printf(before > 0 ? "\t%.3f" : "\t-", ns / before);
+        printf("\n");
+        fflush(stdout);
+    }
+
+    if (file != NULL)
+        fclose(file);
+    return 0;
+}
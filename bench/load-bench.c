@@ -0,0 +1,81 @@
+// Include library source first, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+#include <time.h>
+
+// Define number of values in file
+#define VALUES 10000000
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Return file of random doubles, one per line, half of them needing strtod(3) fallback
+static FILE *generate(void)
+{
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return NULL;
+
+    unsigned long state = 1;
+    for (size_t i = 0; i < VALUES; i++)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        unsigned long bits = state >> 33;
+        if (i % 2)
+            fprintf(file, "%.17g\n", (double)bits / 3.0e7);
+        else
+            fprintf(file, "%lu.%03lu\n", bits % 100000, bits % 1000);
+    }
+    fflush(file);
+    return file;
+}
+
+// Return stream of file from its start
+static stream *rewound(FILE *file)
+{
+    lseek(fileno(file), 0, SEEK_SET);
+    return create_fd_stream(fileno(file));
+}
+
+int main(void)
+{
+    FILE *file = generate();
+    if (file == NULL)
+        return 1;
+
+    // Read values one at a time with get_double function
+    stream *s = rewound(file);
+    double start = now(), sum = 0;
+    for (size_t i = 0; i < VALUES; i++)
+        sum += get_double_from(s, NULL);
+    double serial = now() - start;
+    destroy_stream(s);
+    fprintf(stderr, "%-16s %8.3f s\n", "get_double", serial);
+
+    // Read values with load_doubles function on growing number of threads
+    size_t most = processors() > 4 ? processors() : 4;
+    for (size_t threads = 1; threads <= most; threads *= 2)
+    {
+        s = rewound(file);
+        size_t count;
+        start = now();
+        double *values = load_doubles(s, &count, NULL, NULL, threads);
+        double elapsed = now() - start;
+        destroy_stream(s);
+
+        double total = 0;
+        for (size_t i = 0; i < count; i++)
+            total += values[i];
+        free(values);
+        if (count != VALUES || total != sum) // Check order and values match get_double function
+            return 2;
+
+        fprintf(stderr, "load, %2zu threads %8.3f s %8.2fx\n", threads, elapsed, serial / elapsed);
+    }
+    return 0;
+}
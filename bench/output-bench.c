@@ -0,0 +1,94 @@
+// Include library source first, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+#include <time.h>
+#include <fcntl.h>
+
+// Define number of values read with prompt, and number of report lines printed after each value
+#define VALUES 200000
+#define REPORT 10
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Return number of write(2) calls made by process so far, or 0 if /proc is not available
+static unsigned long long writes(void)
+{
+    unsigned long long count = 0;
+    FILE *file = fopen("/proc/self/io", "r");
+    if (file == NULL)
+        return 0;
+
+    char line[128];
+    while (fgets(line, sizeof(line), file) != NULL)
+        if (sscanf(line, "syscw: %llu", &count) == 1)
+            break;
+    fclose(file);
+    return count;
+}
+
+// Generate file of values for every policy on standard input, and send standard output to /dev/null
+static bool generate(size_t policies)
+{
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < VALUES * policies; i++)
+        fprintf(file, "%zu\n", i % 1000);
+    fflush(file);
+    rewind(file);
+
+    int null = open("/dev/null", O_WRONLY);
+    return null >= 0 && dup2(fileno(file), STDIN_FILENO) >= 0 && dup2(null, STDOUT_FILENO) >= 0;
+}
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        output_mode mode;
+        prompt_mode prompts;
+    } policies[] = {
+        {"unbuffered", OUTPUT_UNBUFFERED, PROMPT_SHOW},
+        {"line", OUTPUT_LINE, PROMPT_SHOW},
+        {"full", OUTPUT_FULL, PROMPT_SHOW},
+        {"full, skip", OUTPUT_FULL, PROMPT_SKIP},
+    };
+    size_t count = sizeof(policies) / sizeof(policies[0]);
+
+    if (!generate(count))
+        return 1;
+
+    // Prompt for each value, then print report lines like host program
+    fprintf(stderr, "%-12s %12s %12s\n", "policy", "writes", "seconds");
+    for (size_t p = 0; p < count; p++)
+    {
+        set_output_mode(policies[p].mode);
+        set_prompt_mode(policies[p].prompts);
+
+        unsigned long long before = writes();
+        double start = now();
+        long long sum = 0;
+        for (size_t i = 0; i < VALUES; i++)
+        {
+            int value = get_int("Value %zu: ", i);
+            for (size_t j = 0; j < REPORT; j++)
+                printf("value %zu, row %zu: %d\n", i, j, value);
+            sum += value;
+        }
+        fflush(stdout);
+        double elapsed = now() - start;
+
+        fprintf(stderr, "%-12s %12llu %12.3f\n", policies[p].name, writes() - before, elapsed);
+        if (sum != (long long)VALUES * 999 / 2) // Check every value was read
+            return 2;
+    }
+    return 0;
+}
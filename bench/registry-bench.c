@@ -0,0 +1,115 @@
+// Include library source first, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+#include <time.h>
+#include <sys/resource.h>
+
+// Define number of lines read or strings registered
+#define LINES 10000000
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Return peak resident set size in MiB
+static double peak(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+// Generate file of lines on standard input
+static bool generate(void)
+{
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+        fprintf(file, "%07zu\n", i % 10000000);
+    fflush(file);
+    rewind(file);
+    return dup2(fileno(file), STDIN_FILENO) >= 0;
+}
+
+// Read lines with get_string from generated file on standard input
+static bool lines(void)
+{
+    size_t count = 0;
+    while (get_string(NULL, NULL) != NULL) // Macro is undefined by library source
+        count++;
+    return count == LINES;
+}
+
+// Register strings with realloc of pointer array on every call, like previous get_string
+static bool array(void)
+{
+    char **array = NULL;
+    size_t allocations = 0;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        char *str = strdup("1234567");
+        char **temp = realloc(array, sizeof(char *) * (allocations + 1));
+        if (str == NULL || temp == NULL)
+            return false;
+        array = temp;
+        array[allocations++] = str;
+    }
+    return true;
+}
+
+// Register strings in paged registry of get_string, after header for index in registry
+static bool pages(void)
+{
+    local *l = own();
+    if (l == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        char *block = malloc(HEADER + 8);
+        if (block == NULL || !store(&l->strings, strcpy(block + HEADER, "1234567"), false))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    bool (*run)(void) = NULL;
+
+    if (argc == 2 && !strcmp(argv[1], "lines"))
+        run = lines;
+    else if (argc == 2 && !strcmp(argv[1], "array"))
+        run = array;
+    else if (argc == 2 && !strcmp(argv[1], "pages"))
+        run = pages;
+
+    if (run == NULL)
+    {
+        fprintf(stderr, "\nUsage: %s lines | array | pages\n\n", argv[0]);
+        return 1;
+    }
+
+    if (run == lines && !generate())
+    {
+        fprintf(stderr, "Error: Unable to generate input\n");
+        return 2;
+    }
+
+    double start = now();
+    if (!run())
+    {
+        fprintf(stderr, "Error: %s benchmark failed\n", argv[1]);
+        return 2;
+    }
+
+    printf("%-8s %10d %10.3f s %10.1f MiB\n", argv[1], LINES, now() - start, peak());
+    return 0;
+}
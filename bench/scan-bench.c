@@ -0,0 +1,117 @@
+// Include library source first, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+#include <time.h>
+
+// Define size of scanned buffer and number of timed passes
+#define BENCH_SIZE (16 << 20)
+#define PASSES 8
+
+typedef struct variant
+{
+    const char *name;
+    scanner kernel;
+    bool supported;
+} variant;
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Check kernel against scalar kernel on random bytes at every offset and length
+static bool verify(scanner kernel)
+{
+    unsigned char bytes[512];
+    unsigned long state = 1;
+
+    for (int round = 0; round < 64; round++)
+    {
+        for (size_t i = 0; i < sizeof(bytes); i++)
+        {
+            state = state * 6364136223846793005UL + 1442695040888963407UL;
+            unsigned r = (state >> 33) % 512;
+            bytes[i] = r == 0 ? '\r' : r == 1 ? '\n' : 'a' + r % 26;
+        }
+
+        for (size_t start = 0; start < 80; start++)
+            for (size_t n = 0; start + n <= sizeof(bytes); n += 1 + n / 8)
+                if (kernel(bytes + start, n) != scan_scalar(bytes + start, n))
+                    return false;
+    }
+    return true;
+}
+
+// Scan buffer of lines with kernel like the reader does and return bytes per second
+static double measure(scanner kernel, const unsigned char *buffer, size_t size)
+{
+    size_t lines = 0;
+    double start = now();
+
+    for (int pass = 0; pass < PASSES; pass++)
+    {
+        const unsigned char *p = buffer, *end = buffer + size;
+        while (p < end)
+        {
+            const unsigned char *ending = kernel(p, end - p);
+            if (ending == NULL)
+                break;
+            p = ending + 1;
+            lines++;
+        }
+    }
+
+    double elapsed = now() - start;
+    if (lines == 0) // Keep loop observable
+        fprintf(stderr, "no lines\n");
+    return (double)size * PASSES / elapsed;
+}
+
+int main(void)
+{
+    variant variants[] = {
+        {"scalar", scan_scalar, true},
+#ifdef SCAN_X86
+        {"sse2", scan_sse2, __builtin_cpu_supports("sse2")},
+        {"avx2", scan_avx2, __builtin_cpu_supports("avx2")},
+        {"avx512", scan_avx512, __builtin_cpu_supports("avx512bw")},
+#endif
+    };
+    size_t count = sizeof(variants) / sizeof(variants[0]);
+    size_t lengths[] = {8, 80, 65536};
+
+    unsigned char *buffer = malloc(BENCH_SIZE);
+    if (buffer == NULL)
+        return 1;
+
+    for (size_t v = 0; v < count; v++)
+        if (variants[v].supported && !verify(variants[v].kernel))
+        {
+            fprintf(stderr, "Error: %s kernel disagrees with scalar kernel\n", variants[v].name);
+            return 2;
+        }
+
+    printf("%-8s %10s %12s\n", "kernel", "line (B)", "MB/s");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+    {
+        // Fill buffer with lines of given length, each followed by LF
+        for (size_t i = 0; i < BENCH_SIZE; i++)
+            buffer[i] = i % (lengths[l] + 1) == lengths[l] ? '\n' : 'a' + i % 26;
+
+        for (size_t v = 0; v < count; v++)
+        {
+            if (!variants[v].supported)
+            {
+                printf("%-8s %10zu %12s\n", variants[v].name, lengths[l], "n/a");
+                continue;
+            }
+            printf("%-8s %10zu %12.1f\n", variants[v].name, lengths[l], measure(variants[v].kernel, buffer, BENCH_SIZE) / 1e6);
+        }
+    }
+
+    free(buffer);
+    return 0;
+}
@@ -14,605 +14,4645 @@
 #include <limits.h>
 #include <float.h>
 
+// Include low-level read(2) for block reads from file descriptors, and isatty(3) for terminal checks
+#if defined(_WIN32)
+#include <io.h>
+#define read _read
+#define isatty _isatty
+#define flockfile _lock_file
+#define funlockfile _unlock_file
+#define getc_unlocked _getc_nolock
+#define STDIN_FILENO 0
+#define STDOUT_FILENO 1
+#else
+#include <unistd.h>
+#endif
+
+// Include mmap(2) to map regular file on standard input instead of reading it in blocks
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define MAP_INPUT
+#endif
+
+// Include poll(2) to check for bytes ready on file descriptors without blocking, and clock for deadlines
+#if !defined(_WIN32)
+#include <poll.h>
+#include <time.h>
+#define POLL_INPUT
+#endif
+
+// Include clock for time counted by statistics
+#ifdef STDPROMPT_STATS
+#include <time.h>
+#endif
+
+// Include mutexes for lists shared by threads and for standard input, threads and condition variables for parsing chunks of input,
+// and keys whose destructors run at thread exit
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef SRWLOCK mutex;
+#define MUTEX_INITIALISER SRWLOCK_INIT
+#define lock(m) AcquireSRWLockExclusive(m)
+#define unlock(m) ReleaseSRWLockExclusive(m)
+typedef CONDITION_VARIABLE condition;
+#define CONDITION_INITIALISER CONDITION_VARIABLE_INIT
+#define sleep_on(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define wake_all(c) WakeAllConditionVariable(c)
+typedef HANDLE thread;
+#define WORKER(FUNC) DWORD WINAPI FUNC(LPVOID argument)
+#define spawn(t, func, arg) ((*(t) = CreateThread(NULL, 0, func, arg, 0, NULL)) != NULL)
+#define join(t) (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+typedef DWORD exit_key;
+#define EXIT_HOOK(FUNC) VOID NTAPI FUNC(PVOID state)
+#define hook_exit(k, func) ((*(k) = FlsAlloc(func)) != FLS_OUT_OF_INDEXES)
+#define mark_exit(k, value) FlsSetValue(k, value)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t mutex;
+#define MUTEX_INITIALISER PTHREAD_MUTEX_INITIALIZER
+#define lock(m) pthread_mutex_lock(m)
+#define unlock(m) pthread_mutex_unlock(m)
+typedef pthread_cond_t condition;
+#define CONDITION_INITIALISER PTHREAD_COND_INITIALIZER
+#define sleep_on(c, m) pthread_cond_wait(c, m)
+#define wake_all(c) pthread_cond_broadcast(c)
+typedef pthread_t thread;
+#define WORKER(FUNC) void *FUNC(void *argument)
+#define spawn(t, func, arg) (pthread_create(t, NULL, func, arg) == 0)
+#define join(t) pthread_join(t, NULL)
+typedef pthread_key_t exit_key;
+#define EXIT_HOOK(FUNC) void FUNC(void *state)
+#define hook_exit(k, func) (pthread_key_create(k, func) == 0)
+#define mark_exit(k, value) pthread_setspecific(k, value)
+#endif
+
+// Define storage class for state of each thread
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
 #include "stdprompt.h"
 
 // Disable warnings on variadic arguments from compilers
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wformat-security"
+#if defined(STDPROMPT_STATS) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // Timing parsers hides their stores from compiler
+#endif
 
 // Define initial macro for buffer capacity in get_string function
 #define BUFFER_CAPACITY 16
 
-// Initialise dynamic array of allocated strings by get_string function
-static char **strings = NULL;
-static size_t allocations = 0;
+// Define macros for number of size classes of line lengths, powers of two from BUFFER_CAPACITY,
+// number of lines counted before halving counts, and percentage of recent lines fitting first buffer of get_string function
+#define LENGTH_CLASSES 16
+#define LENGTH_WINDOW 256
+#define LENGTH_PERCENTILE 95
 
-// Prompt user for line of characters from standard input
-// Return string (char *) value. If user inputs only line ending, returns "" not NULL
-// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings
-// Return NULL on errors or no input (EOF)
-// Store string on heap, library destructor frees memory on program exit
-// Format prompt like printf(3) function for user
-#undef get_string
-char *get_string(va_list *args, const char *format, ...)
+// Define macro for smallest slack of string buffer returned to allocator when minimising it
+#define SHRINK_SLACK 32
+
+// Define macro for block capacity of reads from standard input
+#define BLOCK_CAPACITY 65536
+
+// Define macro for number of string pointers in each page of registry
+#define PAGE_CAPACITY 1024
+
+// Define macro for size of header stored before each string on heap with its index in registry
+#define HEADER sizeof(size_t)
+
+// Define macros for bytes of short string kept in cell of pool with its terminating zero, bytes of each cell with its header,
+// and number of cells in each page of pool
+#define POOL_STRING 24
+#define POOL_CELL (HEADER + POOL_STRING)
+#define POOL_CELLS 127
+
+// Define macro for flag in header of string stored in cell of pool instead of its own allocation
+#define POOLED ((size_t)1 << (sizeof(size_t) * CHAR_BIT - 1))
+
+// Define page of pool of short strings, packing cells of header and characters contiguously
+typedef struct cells
+{
+    struct cells *next;                        // Next page of pool
+    unsigned char data[POOL_CELLS][POOL_CELL]; // Cells of header and characters
+} cells;
+
+// Define registry of allocated strings by get_string function
+// Store pointers in fixed-size pages that never move, with directory of pages growing exponentially
+// Index strings from first page onwards, and recycle first page once every string in it is freed
+typedef struct registry
 {
-    // Check for space in dynamic array
-    if (allocations >= SIZE_MAX / sizeof(char *))
+    char ***pages;        // Directory of pages of string pointers
+    size_t capacity;      // Number of page pointers in directory
+    size_t count;         // Number of allocated pages
+    size_t base;          // Index of first string in first page
+    size_t oldest;        // Index of oldest string not yet freed
+    size_t allocations;   // Index past last stored string
+    size_t live;          // Number of strings not yet freed
+    size_t limit;         // Maximum number of strings kept, or 0 for no limit
+    cells *pool;          // Pages of pool of short strings, newest first
+    size_t carved;        // Number of cells handed out from newest page of pool
+    unsigned char *spare; // Freed cells of pool, each linking next freed cell after its header
+} registry;
+
+// Define prompt rendered by typed wrapper function, written again on retries without formatting
+typedef struct rendering
+{
+    char *text;      // Characters of rendered prompt, not terminated by '\0'
+    size_t size;     // Number of characters in rendered prompt
+    size_t capacity; // Number of bytes in buffer of rendered prompt
+    bool valid;      // Indicate prompt of current wrapper function call is rendered
+} rendering;
+
+// Define state of each thread, so functions never contend on globals
+// Free state of thread at its exit, but keep state with strings still allocated until program exit, since strings may outlive their thread
+typedef struct local
+{
+    registry strings;   // Registry of strings allocated on heap by thread
+    arena *scope;       // Arena in use by thread, or NULL for heap
+    rendering cache;    // Prompt rendered by typed wrapper functions of thread
+    input_status status; // Status of last call reading input in thread
+#ifdef STDPROMPT_STATS
+    input_stats stats;  // Statistics counted by thread
+#endif
+    struct local *next; // Next state in list of states
+} local;
+
+// Initialise state of calling thread, list of states of every thread, and lock of lists shared by threads
+static THREAD_LOCAL local *self = NULL;
+static local *locals = NULL;
+static mutex shared = MUTEX_INITIALISER;
+
+// Initialise key whose destructor frees state of thread at its exit, created by setup function
+static exit_key leaving;
+static bool hooked = false;
+
+// Return state of calling thread, creating it on first call
+// Return NULL on errors
+static local *own(void)
+{
+    if (self != NULL)
+        return self;
+
+    local *l = calloc(1, sizeof(local));
+    if (l == NULL)
         return NULL;
 
-    // Prompt user using formatted string with variadic arguments
-    if (format != NULL)
+    lock(&shared); // Prepend state to list of states
+    l->next = locals;
+    locals = l;
+    unlock(&shared);
+
+    if (hooked) // Free state at thread exit
+        mark_exit(leaving, l);
+    self = l;
+    return l;
+}
+
+#ifdef STDPROMPT_STATS
+// Load and store counters of thread atomically, since only thread itself writes them but any thread takes snapshots
+#if defined(__GNUC__)
+#define LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_RELAXED)
+#define STORE(counter, value) __atomic_store_n(&(counter), (value), __ATOMIC_RELAXED)
+#else
+#define LOAD(counter) (counter)
+#define STORE(counter, value) ((counter) = (value))
+#endif
+#define ADD(counter, n) STORE(counter, LOAD(counter) + (n))
+
+// Add n to counter of statistics of calling thread, skipping threads without state instead of allocating it
+// Read state directly, so counting during teardown never touches freed state or creates state again
+#define STAT(field, n)                    \
+    do                                    \
+    {                                     \
+        if (self != NULL)                 \
+            ADD(self->stats.field, n);    \
+    } while (0)
+
+// Create state of calling thread at start of counted call, so its counters have somewhere to go
+#define COUNTING() ((void)own())
+
+// Initialise counters of threads already exited, whose states are freed
+static input_stats retired;
+
+// Add counters of thread to sum
+static void add_stats(input_stats *sum, const input_stats *counted)
+{
+    sum->lines += LOAD(counted->lines);
+    sum->bytes += LOAD(counted->bytes);
+    sum->reads += LOAD(counted->reads);
+    sum->grows += LOAD(counted->grows);
+    sum->strings += LOAD(counted->strings);
+    sum->pages += LOAD(counted->pages);
+    sum->expansions += LOAD(counted->expansions);
+    for (size_t i = 0; i < STATS_GETTERS; i++)
+        sum->retries[i] += LOAD(counted->retries[i]);
+    sum->read_ns += LOAD(counted->read_ns);
+    sum->parse_ns += LOAD(counted->parse_ns);
+}
+#else
+// Compile counting out, without evaluating arguments
+#define STAT(field, n) ((void)0)
+#define COUNTING() ((void)0)
+#endif
+
+// Return slot of string with index in registry
+static char **slot(registry *r, size_t i)
+{
+    return &r->pages[(i - r->base) / PAGE_CAPACITY][(i - r->base) % PAGE_CAPACITY];
+}
+
+// Take cell for short string from pool of registry, reusing freed cell or carving next cell of newest page
+// Return characters of cell after its header, or NULL on errors
+static char *take_cell(registry *r)
+{
+    unsigned char *cell = r->spare;
+    if (cell != NULL) // Reuse freed cell
     {
-        va_list ap;
+        memcpy(&r->spare, cell + HEADER, sizeof(unsigned char *));
+        return (char *)cell + HEADER;
+    }
 
-        if (args == NULL)
-            va_start(ap, format);
-        else
-            va_copy(ap, *args); // Copy wrapper function arguments into variadic list
+    if (r->pool == NULL || r->carved == POOL_CELLS) // Allocate page if newest page is full
+    {
+        cells *page = malloc(sizeof(cells));
+        if (page == NULL)
+            return NULL;
+        page->next = r->pool;
+        r->pool = page;
+        r->carved = 0;
+    }
+    return (char *)r->pool->data[r->carved++] + HEADER;
+}
 
-        vprintf(format, ap);
-        va_end(ap);
+// Return cell of short string to freed cells of pool of registry
+static void give_cell(registry *r, char *str)
+{
+    memcpy(str, &r->spare, sizeof(unsigned char *));
+    r->spare = (unsigned char *)str - HEADER;
+}
+
+// Free string in slot of registry
+static void discard(registry *r, char **entry)
+{
+    if (*entry == NULL)
+        return;
+
+    size_t header;
+    memcpy(&header, *entry - HEADER, HEADER);
+    if (header & POOLED) // Return cell to pool
+        give_cell(r, *entry);
+    else
+        free(*entry - HEADER); // Free string with its header
+    *entry = NULL;
+    r->live--;
+    STAT(strings, -1);
+}
+
+// Advance oldest index past freed strings, and move pages of freed strings to end of directory for reuse
+static void settle(registry *r)
+{
+    while (r->oldest < r->allocations && *slot(r, r->oldest) == NULL)
+        r->oldest++;
+
+    while (r->oldest - r->base >= PAGE_CAPACITY)
+    {
+        char **page = r->pages[0];
+        memmove(r->pages, r->pages + 1, sizeof(char **) * (r->count - 1));
+        r->pages[r->count - 1] = page;
+        r->base += PAGE_CAPACITY;
     }
+}
 
-    // Initialise dynamic buffer for characters
-    size_t capacity = BUFFER_CAPACITY;
-    unsigned char *buffer = malloc(capacity);
-    if (buffer == NULL)
-        return NULL;
+// Free oldest strings beyond limit of registry
+static void trim(registry *r)
+{
+    while (r->limit != 0 && r->live > r->limit)
+    {
+        discard(r, slot(r, r->oldest));
+        settle(r);
+    }
+}
 
-    size_t size = 0; // Indicate number of characters in buffer
-    int c;           // Read character or EOF
+// Append string with header to registry, flagging string in cell of pool, and free oldest strings beyond limit
+// Return false on errors, leaving registry unchanged
+static bool store(registry *r, char *str, bool pooled)
+{
+    size_t page = (r->allocations - r->base) / PAGE_CAPACITY;
 
-    // Get characters iteratively from standard input
-    // Check CR (\r), LF (\n), and CRLF (\r\n)
-    while ((c = fgetc(stdin)) != '\r' && c != '\n' && c != EOF)
+    if (page == r->count) // Allocate page if last page is full
     {
-        if (size + 1 > capacity) // Grow buffer if necessary
+        if (r->count == r->capacity) // Grow directory if necessary
         {
-            if (capacity >= SIZE_MAX / 2) // Consider terminating zero
-            {
-                free(buffer);
-                return NULL;
-            }
+            if (r->capacity >= SIZE_MAX / 2 / sizeof(char **))
+                return false;
 
-            capacity *= 2; // Increment buffer capacity exponentially
+            size_t capacity = r->capacity == 0 ? 16 : r->capacity * 2; // Increment directory capacity exponentially
 
-            unsigned char *temp = realloc(buffer, capacity);
+            char ***temp = realloc(r->pages, sizeof(char **) * capacity);
             if (temp == NULL)
-            {
-                free(buffer);
-                return NULL;
-            }
-            buffer = temp;
+                return false;
+            r->pages = temp;
+            r->capacity = capacity;
+            STAT(expansions, 1);
         }
 
-        buffer[size++] = c; // Append current character to buffer
+        r->pages[page] = malloc(sizeof(char *) * PAGE_CAPACITY);
+        if (r->pages[page] == NULL)
+            return false;
+        r->count++;
+        STAT(pages, 1);
     }
 
-    // Check for no input from user
-    if (size == 0 && c == EOF)
+    size_t header = r->allocations | (pooled ? POOLED : 0);
+    memcpy(str - HEADER, &header, HEADER); // Record index in header of string
+    *slot(r, r->allocations) = str;                // Append string to last page
+    r->allocations++;
+    r->live++;
+    STAT(strings, 1);
+
+    trim(r);
+    return true;
+}
+
+// Free every string stored in registry from index onwards
+static void unwind(registry *r, size_t mark)
+{
+    if (mark < r->oldest) // Strings before oldest are already freed
+        mark = r->oldest;
+
+    for (size_t i = mark; i < r->allocations; i++)
+        discard(r, slot(r, i));
+
+    r->allocations = mark;
+    settle(r);
+}
+
+// Free registry and every string stored in it
+static void release(registry *r)
+{
+    unwind(r, r->oldest); // Free allocated strings
+
+    for (size_t i = 0; i < r->count; i++)
+        free(r->pages[i]); // Free pages
+
+    free(r->pages); // Free directory
+
+    while (r->pool != NULL) // Free pages of pool
     {
-        free(buffer);
-        return NULL;
+        cells *page = r->pool;
+        r->pool = page->next;
+        free(page);
     }
+    *r = (registry){NULL, 0, 0, 0, 0, 0, 0, 0, NULL, 0, NULL};
+}
+
+// Free string allocated on heap by get_string function in calling thread, before program exit
+// Ignore NULL and strings already freed
+void free_string(char *str)
+{
+    if (str == NULL || self == NULL)
+        return;
+
+    registry *r = &self->strings;
+    size_t i;
+    memcpy(&i, str - HEADER, HEADER); // Read index from header of string
+    i &= ~POOLED;
+
+    // Check string is still stored at index in registry
+    if (i < r->oldest || i >= r->allocations || *slot(r, i) != str)
+        return;
+
+    discard(r, slot(r, i));
+    settle(r);
+}
+
+// Return mark of strings allocated on heap by get_string function in calling thread so far
+size_t checkpoint_strings(void)
+{
+    return self != NULL ? self->strings.allocations : 0;
+}
 
-    // Check space for terminating zero
-    if (size == SIZE_MAX)
+// Free every string allocated on heap by get_string function in calling thread since mark
+void rollback_strings(size_t mark)
+{
+    if (self != NULL && mark < self->strings.allocations)
+        unwind(&self->strings, mark);
+}
+
+// Keep only last limit strings allocated on heap by get_string function in calling thread, freeing older strings
+// Keep every string if limit is 0
+void keep_strings(size_t limit)
+{
+    local *l = own();
+    if (l == NULL)
+        return;
+
+    l->strings.limit = limit;
+    trim(&l->strings);
+}
+
+// Free state of thread at its exit, keeping its counters for get_stats function
+// Keep state with strings still allocated until program exit, freeing only its rendered prompt
+// Ignore state no longer in list of states, freed by teardown function
+static EXIT_HOOK(leave)
+{
+    local *l = state;
+    if (self == l) // Stop counting into state being freed
+        self = NULL;
+
+    lock(&shared);
+    local **link = &locals;
+    while (*link != NULL && *link != l)
+        link = &(*link)->next;
+    bool found = *link != NULL, kept = found && l->strings.live > 0;
+    if (found && !kept) // Unlink state from list of states
     {
-        free(buffer);
-        return NULL;
+        *link = l->next;
+#ifdef STDPROMPT_STATS
+        add_stats(&retired, &l->stats);
+#endif
     }
+    unlock(&shared);
 
-    // Check for CRLF (\r\n)
-    if (c == '\r')
+    if (!found)
+        return;
+    free(l->cache.text);
+    l->cache = (rendering){NULL, 0, 0, false};
+    if (!kept)
     {
-        int next = fgetc(stdin);
-        if (next != '\n' && next != EOF)
-            if (ungetc(next, stdin) == EOF)
-            {
-                free(buffer);
-                return NULL;
-            }
+        release(&l->strings);
+        free(l);
     }
+}
 
-    // Minimise buffer
-    unsigned char *str = realloc(buffer, size + 1);
-    if (str == NULL)
+// Define macro for capacity of each slab in arena
+#define SLAB_CAPACITY 65536
+
+// Define slab of arena with strings packed one after another
+typedef struct slab
+{
+    struct slab *next;     // Previous slab of arena
+    size_t capacity;       // Number of bytes in slab
+    size_t used;           // Number of bytes taken by strings
+    unsigned char data[];  // Bytes of strings
+} slab;
+
+// Define arena of strings allocated by get_string function
+struct arena
+{
+    slab *slabs;         // Current slab, linked to previous slabs
+    struct arena *prev;  // Previous arena in list of arenas
+    struct arena *next;  // Next arena in list of arenas
+};
+
+// Initialise list of arenas
+static arena *arenas = NULL;
+
+// Make room for line of needed bytes in current slab of arena, keeping its first size bytes
+// Grow slab in place if it holds only this line, otherwise move line to new slab
+// Return current slab, or NULL on errors
+static slab *expand(arena *a, size_t size, size_t needed)
+{
+    size_t capacity = SLAB_CAPACITY;
+    while (capacity < needed) // Increment slab capacity exponentially
     {
-        free(buffer);
-        return NULL;
+        if (capacity >= (SIZE_MAX - sizeof(slab)) / 2)
+            return NULL;
+        capacity *= 2;
+    }
+
+    slab *s = a->slabs;
+    if (s != NULL && s->used == 0)
+    {
+        slab *temp = realloc(s, sizeof(slab) + capacity);
+        if (temp == NULL)
+            return NULL;
+        temp->capacity = capacity;
+        a->slabs = temp;
+        return temp;
     }
-    str[size] = '\0'; // Terminate string
 
-    // Resize dynamic array to append string
-    char **temp = realloc(strings, sizeof(char *) * (allocations + 1));
+    slab *temp = malloc(sizeof(slab) + capacity);
     if (temp == NULL)
+        return NULL;
+    temp->next = s;
+    temp->capacity = capacity;
+    temp->used = 0;
+
+    if (size > 0) // Move partial line to new slab
+        memcpy(temp->data, s->data + s->used, size);
+
+    a->slabs = temp;
+    return temp;
+}
+
+// Allocate size bytes in current slab of arena, aligned for any type
+// Return memory, or NULL on errors
+static void *carve(arena *a, size_t size)
+{
+    const size_t align = _Alignof(max_align_t);
+    if (size > SIZE_MAX - sizeof(slab) - align)
+        return NULL;
+
+    slab *s = a->slabs;
+    size_t pad = -(uintptr_t)(s->data + s->used) & (align - 1); // Skip bytes up to next aligned address
+    if (pad + size > s->capacity - s->used)
+    {
+        if ((s = expand(a, 0, size + align - 1)) == NULL) // Consider padding in new slab
+            return NULL;
+        pad = -(uintptr_t)(s->data + s->used) & (align - 1);
+    }
+
+    void *memory = s->data + s->used + pad;
+    s->used += pad + size;
+    return memory;
+}
+
+// Create arena for strings allocated by get_string function
+// Return NULL on errors
+arena *create_arena(void)
+{
+    arena *a = malloc(sizeof(arena));
+    if (a == NULL)
+        return NULL;
+
+    a->slabs = NULL;
+    if (expand(a, 0, 0) == NULL) // Allocate first slab
     {
-        free(str);
+        free(a);
         return NULL;
     }
-    strings = temp;
 
-    strings[allocations++] = (char *)str; // Append string to global array
-    return (char *)str;                   // Return string
+    // Prepend arena to list of arenas
+    lock(&shared);
+    a->prev = NULL;
+    a->next = arenas;
+    if (arenas != NULL)
+        arenas->prev = a;
+    arenas = a;
+    unlock(&shared);
+    return a;
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return char value. If string does not represent single char, prompt user to retry
-// Return CHAR_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-char get_char(const char *format, ...)
+// Free every string in arena, keeping first slab for reuse
+void reset_arena(arena *a)
 {
-    va_list ap;
-    va_start(ap, format);
+    if (a == NULL)
+        return;
 
-    // Try to get char from user
-    while (true)
+    slab *s = a->slabs;
+    while (s->next != NULL)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return CHAR_MAX; // Return sentinel value on error
-        }
+        slab *next = s->next;
+        free(s);
+        s = next;
+    }
 
-        if (*str && *(str + 1) == '\0') // Accept single char
-        {
-            va_end(ap);
-            return *str;
-        }
+    s->used = 0;
+    a->slabs = s;
+}
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+// Free arena and every string in it
+void destroy_arena(arena *a)
+{
+    if (a == NULL)
+        return;
 
-        if (*str == '\0') // Check for empty string
-            continue;
+    if (self != NULL && self->scope == a) // Return get_string function to heap in calling thread
+        self->scope = NULL;
 
-        char *end = str + strlen(str) - 1;
-        while (end > str && isspace((unsigned char)*end)) // Trim trailing whitespace
-            *end-- = '\0';
+    // Unlink arena from list of arenas
+    lock(&shared);
+    if (a->prev != NULL)
+        a->prev->next = a->next;
+    else
+        arenas = a->next;
+    if (a->next != NULL)
+        a->next->prev = a->prev;
+    unlock(&shared);
 
-        if (*str && *(str + 1) == '\0') // Return char if single char is provided
-        {
-            va_end(ap);
-            return *str;
-        }
+    for (slab *s = a->slabs; s != NULL;)
+    {
+        slab *next = s->next;
+        free(s);
+        s = next;
     }
+    free(a);
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return unsigned char value. If string does not represent single char, prompt user to retry
-// Return UCHAR_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-unsigned char get_unsigned_char(const char *format, ...)
+// Allocate strings from get_string function in calling thread in arena, or on heap if arena is NULL
+// Return arena previously in use, or NULL for heap
+arena *use_arena(arena *a)
 {
-    va_list ap;
-    va_start(ap, format);
+    local *l = own();
+    if (l == NULL)
+        return NULL;
 
-    // Try to get char from user
-    while (true)
-    {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return UCHAR_MAX; // Return sentinel value on error
-        }
+    arena *previous = l->scope;
+    l->scope = a;
+    return previous;
+}
 
-        if (*str && *(str + 1) == '\0') // Accept single char
-        {
-            va_end(ap);
-            return (unsigned char)*str;
-        }
+// Define kinds of sources of block reader
+typedef enum source
+{
+    SOURCE_FD,      // Read blocks from file descriptor, or map regular file
+    SOURCE_FILE,    // Read lines from FILE stream, leaving rest of stream to caller
+    SOURCE_MEMORY,  // Use bytes in memory as single block
+    SOURCE_CALLBACK // Read blocks from function of caller
+} source;
+
+// Define block reader for stream or standard input
+typedef struct reader
+{
+    const unsigned char *block;     // Block of bytes read from source, mapping of file, or bytes in memory
+    size_t start;                   // Index of first unread byte in block
+    size_t end;                     // Index past last read byte in block
+    bool eof;                       // Indicate end of input or read error
+    bool cr;                        // Indicate last line ended with CR, so next LF belongs to CRLF
+    unsigned char *line;            // Buffer for line viewed across blocks
+    size_t capacity;                // Number of bytes in line buffer
+    char *scratch;                  // Buffer for line parsed by typed wrapper functions
+    size_t room;                    // Number of bytes in scratch buffer
+    bool probed;                    // Indicate source was checked for single block on first fill
+    unsigned char *map;             // Mapping of regular file, or NULL
+    size_t mapped;                  // Number of bytes in mapping
+    unsigned char *buffer;          // Block on heap for reads from source, allocated on first read
+    source kind;                    // Kind of source
+    int fd;                         // File descriptor of SOURCE_FD
+    FILE *file;                     // Stream of SOURCE_FILE
+    const unsigned char *bytes;     // Bytes of SOURCE_MEMORY
+    size_t size;                    // Number of bytes of SOURCE_MEMORY
+    stream_callback callback;       // Function of SOURCE_CALLBACK
+    void *context;                  // Argument of callback
+    bool timed;                     // Indicate each call has deadline
+    int timeout;                    // Milliseconds allowed for each call, if timed
+    long long deadline;             // Monotonic time in milliseconds when current call times out, if timed
+    bool timed_out;                 // Indicate current call reached deadline
+    bool counted;                   // Indicate retries of typed wrapper functions are limited
+    size_t retries;                 // Maximum number of retries of each call, if counted
+    size_t attempts;                // Number of retries in current call
+    size_t partial;                 // Number of characters of line left in line buffer by timeout
+    input_status status;            // Status of current call
+    bool capped;                    // Indicate lines are limited to limit characters
+    size_t limit;                   // Maximum number of characters of each line, if capped
+    line_policy policy;             // Policy for lines longer than limit
+    size_t length;                  // Number of characters of current line kept so far
+    bool skipping;                  // Indicate characters beyond limit are discarded up to line ending
+    bool overlong;                  // Indicate current line exceeded limit
+    size_t lengths[LENGTH_CLASSES]; // Number of recent strings in each size class of line lengths
+    size_t measured;                // Number of recent strings counted in size classes
+    size_t expected;                // Capacity of first buffer of get_string functions, or 0 before first string
+} reader;
+
+// Initialise block reader for standard input
+static reader input = {.kind = SOURCE_FD, .fd = STDIN_FILENO};
+
+// Define stream of input with its own block reader
+struct stream
+{
+    reader reader;        // Block reader of stream
+    struct stream *prev;  // Previous stream in list of streams
+    struct stream *next;  // Next stream in list of streams
+};
+
+// Initialise list of streams
+static stream *streams = NULL;
+
+// Create stream with block reader for source, and prepend it to list of streams
+// Return NULL on errors
+static stream *create_stream(reader r)
+{
+    stream *s = malloc(sizeof(stream));
+    if (s == NULL)
+        return NULL;
+
+    s->reader = r;
+    lock(&shared);
+    s->prev = NULL;
+    s->next = streams;
+    if (streams != NULL)
+        streams->prev = s;
+    streams = s;
+    unlock(&shared);
+    return s;
+}
+
+// Create stream reading lines from FILE stream, leaving stream at start of next line after each read
+// Read character after CR (\r) to tell CRLF (\r\n) apart, putting it back with ungetc(3) otherwise
+// Return NULL on errors
+stream *create_file_stream(FILE *file)
+{
+    if (file == NULL)
+        return NULL;
+    return create_stream((reader){.kind = SOURCE_FILE, .file = file});
+}
+
+// Create stream reading blocks from file descriptor, or mapping it if it is regular file
+// Return NULL on errors
+stream *create_fd_stream(int fd)
+{
+    if (fd < 0)
+        return NULL;
+    return create_stream((reader){.kind = SOURCE_FD, .fd = fd});
+}
+
+// Create stream reading size bytes in memory without copying them
+// Return NULL on errors
+stream *create_memory_stream(const char *data, size_t size)
+{
+    if (data == NULL && size > 0)
+        return NULL;
+    return create_stream((reader){.kind = SOURCE_MEMORY, .bytes = (const unsigned char *)data, .size = size});
+}
+
+// Create stream reading blocks from callback, called with context, buffer, and capacity of buffer
+// Return NULL on errors
+stream *create_callback_stream(stream_callback callback, void *context)
+{
+    if (callback == NULL)
+        return NULL;
+    return create_stream((reader){.kind = SOURCE_CALLBACK, .callback = callback, .context = context});
+}
+
+// Free buffers of block reader and unmap its file
+static void close_reader(reader *r)
+{
+    free(r->buffer);
+    free(r->line);
+    free(r->scratch);
+#ifdef MAP_INPUT
+    if (r->map != NULL)
+        munmap(r->map, r->mapped);
+#endif
+}
+
+// Free stream and its buffers, without closing its file, file descriptor, or memory
+void destroy_stream(stream *s)
+{
+    if (s == NULL)
+        return;
+
+    // Unlink stream from list of streams
+    lock(&shared);
+    if (s->prev != NULL)
+        s->prev->next = s->next;
+    else
+        streams = s->next;
+    if (s->next != NULL)
+        s->next->prev = s->prev;
+    unlock(&shared);
+
+    close_reader(&s->reader);
+    free(s);
+}
+
+// Initialise lock of standard input, shared by every thread
+static mutex input_lock = MUTEX_INITIALISER;
+
+// Return monotonic time in milliseconds
+static long long milliseconds(void)
+{
+#ifdef POLL_INPUT
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#else
+    return 0;
+#endif
+}
+
+#ifdef STDPROMPT_STATS
+// Return monotonic time in nanoseconds, or calendar time where monotonic clock is missing
+static uint64_t nanoseconds(void)
+{
+    struct timespec ts;
+#ifdef POLL_INPUT
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Initialise start of parse timed in calling thread
+static THREAD_LOCAL uint64_t parsing;
+
+// Start timing parse
+static inline void start_parse(void)
+{
+    parsing = nanoseconds();
+}
+
+// Count time since parse started
+// Return status of parse
+static inline input_status end_parse(input_status status)
+{
+    STAT(parse_ns, nanoseconds() - parsing);
+    return status;
+}
+
+// Time parse function call, evaluating to its status
+#define PARSE(call) (start_parse(), end_parse(call))
+#else
+#define PARSE(call) (call)
+#endif
+
+// Return block reader of stream, or of standard input if stream is NULL, locking standard input until relinquished
+// Start deadline and count of retries of call
+static reader *acquire(stream *s)
+{
+    reader *r = &input;
+    if (s != NULL)
+        r = &s->reader;
+    else
+        lock(&input_lock);
+
+    COUNTING();
+    r->status = INPUT_OK;
+    r->timed_out = false;
+    r->attempts = 0;
+    if (r->timed)
+        r->deadline = milliseconds() + r->timeout;
+    return r;
+}
+
+// Record status of call for get_status function, and unlock standard input if reader is of standard input
+static void relinquish(reader *r)
+{
+    local *l = own();
+    if (l != NULL)
+        l->status = r->status;
+
+    if (r == &input)
+        unlock(&input_lock);
+}
+
+// Return reader of stream to configure, or of standard input if stream is NULL, locking standard input until unlocked
+// Leave status of last call and state of calling thread untouched, unlike acquire function
+static reader *configure(stream *s)
+{
+    if (s != NULL)
+        return &s->reader;
+    lock(&input_lock);
+    return &input;
+}
+
+// Set deadline of each call reading stream, or standard input if stream is NULL, and maximum number of retries of typed wrapper functions
+// Wait forever if timeout is negative, and retry forever if retries is SIZE_MAX
+void set_limits(stream *s, int timeout, size_t retries)
+{
+    reader *r = configure(s);
+    r->timed = timeout >= 0;
+    r->timeout = timeout;
+    r->counted = retries != SIZE_MAX;
+    r->retries = retries;
+    if (r == &input)
+        unlock(&input_lock);
+}
+
+// Set maximum number of characters of each line read from stream, or standard input if stream is NULL,
+// and policy for longer lines. Read lines of any length if limit is SIZE_MAX
+void set_line_limit(stream *s, size_t limit, line_policy policy)
+{
+    reader *r = configure(s);
+    r->capped = limit != SIZE_MAX;
+    r->limit = limit;
+    r->policy = policy;
+    if (r == &input)
+        unlock(&input_lock);
+}
+
+// Return status of last call reading input in calling thread
+input_status get_status(void)
+{
+    return self != NULL ? self->status : INPUT_OK;
+}
+
+// Define macro for capacity of buffer for standard output
+#define OUTPUT_CAPACITY 65536
+
+// Initialise buffering policy of standard output, resolved by setup function, and its buffer
+static output_mode output = OUTPUT_UNBUFFERED;
+static char output_buffer[OUTPUT_CAPACITY];
+
+// Set buffering of standard output, resolving OUTPUT_AUTO to line buffering on terminal and full buffering otherwise
+// Flush standard output before changing buffering, and before each read from standard input if output is buffered
+// Return policy previously in use
+output_mode set_output_mode(output_mode mode)
+{
+    output_mode previous = output;
+    if (mode == OUTPUT_AUTO)
+        mode = isatty(STDOUT_FILENO) ? OUTPUT_LINE : OUTPUT_FULL;
+
+    // Give buffer explicitly, since stream may keep its one-byte buffer after unbuffered mode
+    fflush(stdout);
+    int buffering = mode == OUTPUT_UNBUFFERED ? _IONBF : mode == OUTPUT_LINE ? _IOLBF : _IOFBF;
+    if (setvbuf(stdout, mode == OUTPUT_UNBUFFERED ? NULL : output_buffer, buffering, OUTPUT_CAPACITY) == 0)
+        output = mode;
+    return previous;
+}
+
+// Grow dynamic buffer to hold at least needed bytes, keeping its contents
+// Return buffer, or NULL on errors, leaving buffer and capacity unchanged
+static void *reserve(void *buffer, size_t *capacity, size_t needed)
+{
+    size_t size = *capacity == 0 ? BUFFER_CAPACITY : *capacity;
+    while (size < needed) // Increment buffer capacity exponentially
+    {
+        if (size >= SIZE_MAX / 2)
+            return NULL;
+        size *= 2;
+    }
+
+    if (buffer != NULL && size == *capacity)
+        return buffer;
+
+    void *temp = realloc(buffer, size);
+    if (temp != NULL)
+        *capacity = size;
+    return temp;
+}
+
+#ifdef MAP_INPUT
+// Map regular file on file descriptor of reader into memory, starting from its current offset, as single block of reader
+// Move file offset past mapping, so reads after mapping continue with bytes appended later
+// Return false if file descriptor is not regular file or cannot be mapped
+static bool map_input(reader *r)
+{
+    struct stat st;
+    if (fstat(r->fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || (uintmax_t)st.st_size > SIZE_MAX)
+        return false;
+
+    off_t offset = lseek(r->fd, 0, SEEK_CUR);
+    if (offset < 0 || offset >= st.st_size)
+        return false;
+
+    size_t size = (size_t)st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, r->fd, 0);
+    if (map == MAP_FAILED)
+        return false;
+
+    if (lseek(r->fd, st.st_size, SEEK_SET) < 0)
+    {
+        munmap(map, size);
+        return false;
+    }
+
+    madvise(map, size, MADV_SEQUENTIAL); // Ask kernel for aggressive readahead
+
+    r->map = map;
+    r->mapped = size;
+    r->block = map;
+    r->start = (size_t)offset;
+    r->end = size;
+    return true;
+}
+#endif
+
+// Read up to capacity bytes from source of reader into buffer
+// Read FILE stream only up to line ending, so stream stays at start of next line for caller
+// Return number of bytes read, 0 at end of input, or negative value on errors
+static ptrdiff_t pull(reader *r, unsigned char *buffer, size_t capacity)
+{
+#ifdef STDPROMPT_STATS
+    uint64_t start = nanoseconds();
+#endif
+    ptrdiff_t n = -1;
+    switch (r->kind)
+    {
+    case SOURCE_FD: // Read whatever is available, retrying on signal interruption
+        do
+            n = read(r->fd, buffer, capacity);
+        while (n < 0 && errno == EINTR);
+        break;
+
+    case SOURCE_FILE:
+    {
+        size_t i = 0;
+        int c;
+        flockfile(r->file); // Lock stream once instead of on every character
+        while (i < capacity && (c = getc_unlocked(r->file)) != EOF)
+        {
+            buffer[i++] = (unsigned char)c;
+            if (c == '\n')
+                break;
+            if (c == '\r') // Take LF of CRLF (\r\n) too, and leave character after CR (\r) in stream
+            {
+                if (i < capacity && (c = getc_unlocked(r->file)) == '\n')
+                    buffer[i++] = '\n';
+                else if (c != EOF)
+                    ungetc(c, r->file);
+                break;
+            }
+        }
+        funlockfile(r->file);
+        n = (ptrdiff_t)i;
+        break;
+    }
+
+    case SOURCE_CALLBACK:
+        n = r->callback(r->context, (char *)buffer, capacity);
+        if (n > (ptrdiff_t)capacity) // Treat overrun of buffer as error
+            n = -1;
+        break;
+
+    default:
+        break;
+    }
+
+#ifdef STDPROMPT_STATS
+    local *l = self; // Count read, its bytes, and time blocked in it
+    if (l != NULL)
+    {
+        ADD(l->stats.reads, 1);
+        ADD(l->stats.bytes, n > 0 ? (size_t)n : 0);
+        ADD(l->stats.read_ns, nanoseconds() - start);
+    }
+#endif
+    return n;
+}
+
+#ifdef POLL_INPUT
+// Wait until file descriptor of reader has bytes ready or deadline of call passes, retrying on signal interruption
+// Return false if deadline passed
+static bool wait_input(reader *r)
+{
+#ifdef STDPROMPT_STATS
+    uint64_t start = nanoseconds();
+#endif
+    struct pollfd ready = {.fd = r->fd, .events = POLLIN};
+    bool waited; // Indicate bytes are ready before deadline
+    while (true)
+    {
+        long long left = r->deadline - milliseconds();
+        int n = poll(&ready, 1, left <= 0 ? 0 : left > INT_MAX ? INT_MAX : (int)left);
+        waited = n > 0 || (n < 0 && errno != EINTR); // Let read report end of input and errors
+        if (waited || (n == 0 && left <= 0))
+            break;
+    }
+    STAT(read_ns, nanoseconds() - start);
+    return waited;
+}
+#endif
+
+// Fill block of reader with bytes from its source
+// Use bytes in memory or mapped regular file as single block on first fill, then read blocks on heap
+// Return false on errors or no input (EOF)
+static bool fill(reader *r)
+{
+    if (r->eof)
+        return false;
+
+    if (!r->probed)
+    {
+        r->probed = true;
+        if (r->kind == SOURCE_MEMORY && r->size > 0) // View bytes in memory without copying them
+        {
+            r->block = r->bytes;
+            r->start = 0;
+            r->end = r->size;
+            STAT(bytes, r->size);
+            return true;
+        }
+#ifdef MAP_INPUT
+        if (r->kind == SOURCE_FD && map_input(r))
+        {
+            STAT(bytes, r->end - r->start);
+            return true;
+        }
+#endif
+    }
+
+    if (r->kind == SOURCE_MEMORY) // Keep EOF sticky like stdio
+    {
+        r->eof = true;
+        return false;
+    }
+
+    // Allocate block on first read
+    if (r->buffer == NULL)
+    {
+        r->buffer = malloc(BLOCK_CAPACITY);
+        if (r->buffer == NULL)
+            return false;
+    }
+
+    // Show prompts and output held in buffer of standard output before waiting for standard input,
+    // leaving lock of standard output alone when reading other streams
+    if (output != OUTPUT_UNBUFFERED && r == &input)
+        fflush(stdout);
+
+#ifdef POLL_INPUT
+    if (r->timed && r->kind == SOURCE_FD && !wait_input(r)) // Keep EOF clear, so next call may read late input
+    {
+        r->timed_out = true;
+        return false;
+    }
+#endif
+
+    // Read up to one block
+    ptrdiff_t n = pull(r, r->buffer, BLOCK_CAPACITY);
+    if (n <= 0) // Keep EOF sticky like stdio
+    {
+        r->eof = true;
+        return false;
+    }
+
+    r->block = r->buffer;
+    r->start = 0;
+    r->end = (size_t)n;
+    return true;
+}
+
+// Define pointer type for kernels that find first CR (\r) or LF (\n) in bytes
+// Return pointer to line ending, or NULL if bytes contain none
+typedef const unsigned char *(*scanner)(const unsigned char *bytes, size_t n);
+
+// Find first CR (\r) or LF (\n) in bytes, 8 bytes at a time in portable C
+static const unsigned char *scan_scalar(const unsigned char *bytes, size_t n)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, 8);
+
+        // Set high bit of bytes that become zero after XOR with CR or LF
+        uint64_t cr = word ^ (ones * '\r');
+        uint64_t lf = word ^ (ones * '\n');
+        if ((((cr - ones) & ~cr) | ((lf - ones) & ~lf)) & highs)
+            break;
+    }
+
+    for (; i < n; i++) // Locate byte in word or tail
+        if (bytes[i] == '\r' || bytes[i] == '\n')
+            return bytes + i;
+
+    return NULL;
+}
+
+// Define SSE2, AVX2, and AVX-512 kernels for x86 with runtime CPU dispatch
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SCAN_X86
+
+// Find first CR (\r) or LF (\n) in bytes, 16 bytes at a time
+__attribute__((target("sse2"))) static const unsigned char *scan_sse2(const unsigned char *bytes, size_t n)
+{
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + i));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return bytes + i + __builtin_ctz(mask);
+    }
+
+    return scan_scalar(bytes + i, n - i); // Scan tail
+}
+
+// Find first CR (\r) or LF (\n) in bytes, 32 bytes at a time
+__attribute__((target("avx2"))) static const unsigned char *scan_avx2(const unsigned char *bytes, size_t n)
+{
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(bytes + i));
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr), _mm256_cmpeq_epi8(chunk, lf)));
+        if (mask != 0)
+            return bytes + i + __builtin_ctz(mask);
+    }
+
+    return scan_sse2(bytes + i, n - i); // Scan tail
+}
+
+// Find first CR (\r) or LF (\n) in bytes, 64 bytes at a time
+// Use masked load for tail, which never faults on bytes past the end
+__attribute__((target("avx512f,avx512bw"))) static const unsigned char *scan_avx512(const unsigned char *bytes, size_t n)
+{
+    const __m512i cr = _mm512_set1_epi8('\r');
+    const __m512i lf = _mm512_set1_epi8('\n');
+
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64)
+    {
+        __m512i chunk = _mm512_loadu_si512((const void *)(bytes + i));
+        __mmask64 mask = _mm512_cmpeq_epi8_mask(chunk, cr) | _mm512_cmpeq_epi8_mask(chunk, lf);
+        if (mask != 0)
+            return bytes + i + __builtin_ctzll(mask);
+    }
+
+    if (i < n) // Scan tail
+    {
+        __mmask64 valid = ((__mmask64)1 << (n - i)) - 1;
+        __m512i chunk = _mm512_maskz_loadu_epi8(valid, bytes + i);
+        __mmask64 mask = (_mm512_cmpeq_epi8_mask(chunk, cr) | _mm512_cmpeq_epi8_mask(chunk, lf)) & valid;
+        if (mask != 0)
+            return bytes + i + __builtin_ctzll(mask);
+    }
+
+    return NULL;
+}
+#endif
+
+// Initialise line ending kernel, replaced by fastest supported kernel in setup function
+static scanner scan = scan_scalar;
+
+// Read next segment of line from reader, up to line ending or end of block, starting with line left by timeout
+// Point bytes at segment, valid until next call, and return number of bytes in segment
+// Set ending to CR (\r) or LF (\n) if line is complete, EOF if input ended or call timed out, or 0 if line continues
+// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings
+static size_t segment(reader *r, const unsigned char **bytes, int *ending)
+{
+    if (r->partial > 0) // Resume line left in line buffer by timeout
+    {
+        size_t n = r->partial;
+        r->partial = 0;
+        *bytes = r->line;
+        *ending = 0;
+        return n;
+    }
+
+    while (true)
+    {
+        if (r->start == r->end && !fill(r))
+        {
+            *ending = EOF;
+            return 0;
+        }
+
+        // Skip LF of CRLF (\r\n) left by previous line
+        if (r->cr)
+        {
+            r->cr = false;
+            if (r->block[r->start] == '\n')
+            {
+                r->start++;
+                continue;
+            }
+        }
+        break;
+    }
+
+    // Find line ending in unread bytes of block
+    *bytes = r->block + r->start;
+    const unsigned char *found = scan(*bytes, r->end - r->start);
+    size_t n = found != NULL ? (size_t)(found - *bytes) : r->end - r->start;
+    r->start += n;
+
+    *ending = 0;
+    if (found != NULL) // Consume line ending
+    {
+        *ending = *found;
+        r->start++;
+        r->cr = *found == '\r'; // Check for CRLF (\r\n) on next read
+    }
+    return n;
+}
+
+// Read next segment of line from reader like segment function, keeping at most limit characters of line if capped
+// Discard characters beyond limit block by block up to line ending, without buffering them, and mark line as long
+static inline size_t bounded(reader *r, const unsigned char **bytes, int *ending)
+{
+    if (!r->capped)
+        return segment(r, bytes, ending);
+
+    bool resumed = r->partial > 0;
+    size_t n = segment(r, bytes, ending);
+    if (resumed) // Count line left by timeout, already within limit
+    {
+        r->length = n;
+        return n;
+    }
+
+    while (r->skipping && *ending == 0) // Discard rest of long line
+        segment(r, bytes, ending);
+
+    if (r->skipping)
+        n = 0;
+    else if (n > r->limit - r->length)
+    {
+        n = r->limit - r->length;
+        r->overlong = true;
+        r->skipping = *ending == 0;
+    }
+    r->length += n;
+
+    if (*ending != 0) // Count next line from start, and keep discarding long line resumed after timeout
+    {
+        r->length = 0;
+        r->skipping = r->skipping && r->timed_out;
+    }
+    return n;
+}
+
+// Return policy for line just read, or LINE_TRUNCATE to keep line within limit, and clear mark of long line
+static inline line_policy verdict(reader *r)
+{
+    if (!r->overlong)
+        return LINE_TRUNCATE;
+    r->overlong = false;
+    return r->policy;
+}
+
+// Keep characters of line read before timeout in line buffer of reader, so next call resumes line
+// Return false and set status of call to timeout or EOF
+static bool suspend(reader *r, const unsigned char *bytes, size_t size)
+{
+    r->status = r->timed_out ? INPUT_TIMEOUT : INPUT_EOF;
+    if (!r->timed_out || size == 0)
+        return false;
+
+    unsigned char *temp = bytes == r->line ? r->line : reserve(r->line, &r->capacity, size);
+    if (temp == NULL)
+        return false;
+    r->line = temp;
+
+    if (bytes != r->line)
+        memmove(r->line, bytes, size);
+    r->partial = size;
+    return false;
+}
+
+// Set status of call to allocation failure
+// Return NULL for readers of strings
+static void *exhausted(reader *r)
+{
+    r->status = INPUT_ALLOC;
+    return NULL;
+}
+
+// Read line from reader into current slab of arena
+// Return string in arena, or NULL on errors or no input (EOF)
+static char *read_arena(reader *r, arena *a)
+{
+    size_t size;        // Indicate number of characters in line
+    line_policy policy; // Indicate policy for line read
+
+    // Read next line over free space of slab if long line is discarded
+    do
+    {
+        size = 0;
+        int c = 0; // Read line ending, EOF, or 0 for more characters
+
+        // Copy segments of line into free space of current slab
+        while (c == 0)
+        {
+            const unsigned char *bytes;
+            size_t n = bounded(r, &bytes, &c);
+
+            slab *s = a->slabs;
+            if (s == NULL || size + n + 1 > s->capacity - s->used) // Consider terminating zero
+                if ((s = expand(a, size, size + n + 1)) == NULL)
+                    return exhausted(r);
+
+            memcpy(s->data + s->used + size, bytes, n); // Append characters to line
+            size += n;
+        }
+
+        // Check for no input from user, keeping line for next call on timeout
+        if ((size == 0 && c == EOF) || r->timed_out)
+        {
+            suspend(r, a->slabs != NULL ? a->slabs->data + a->slabs->used : NULL, size);
+            return NULL;
+        }
+    } while ((policy = verdict(r)) == LINE_DISCARD);
+
+    if (policy == LINE_REJECT) // Fail call for long line
+    {
+        r->status = INPUT_LONG;
+        return NULL;
+    }
+
+    // Terminate string and bump free space of slab past it
+    slab *s = a->slabs;
+    char *str = (char *)s->data + s->used;
+    str[size] = '\0';
+    s->used += size + 1;
+    STAT(lines, 1);
+    return str;
+}
+
+// Read line from reader without copying it if line is in one block, otherwise copy line into line buffer of reader
+// Point view at line, valid until next read
+// Return false on errors or no input (EOF)
+static bool view_line(reader *r, line_view *view)
+{
+    line_policy policy; // Indicate policy for line read
+
+    // Read next line if long line is discarded
+    do
+    {
+        const unsigned char *bytes;
+        int c;
+        size_t n = bounded(r, &bytes, &c);
+
+        if (c == EOF) // Check for no input from user
+            return suspend(r, NULL, 0);
+
+        if (c != 0) // View line in block
+        {
+            *view = (line_view){(const char *)bytes, n};
+            continue;
+        }
+
+        // Copy segments of line into line buffer, except line left by timeout already there
+        size_t size = 0;
+        while (true)
+        {
+            if (bytes != r->line)
+            {
+                unsigned char *temp = reserve(r->line, &r->capacity, size + n); // Grow line buffer if necessary
+                if (temp == NULL)
+                {
+                    r->status = INPUT_ALLOC;
+                    return false;
+                }
+                r->line = temp;
+
+                memcpy(r->line + size, bytes, n); // Append characters to line buffer
+            }
+            size += n;
+
+            if (c != 0)
+                break;
+            n = bounded(r, &bytes, &c);
+        }
+
+        if (r->timed_out) // Keep line for next call
+            return suspend(r, r->line, size);
+
+        *view = (line_view){(const char *)r->line, size};
+    } while ((policy = verdict(r)) == LINE_DISCARD);
+
+    if (policy == LINE_REJECT) // Fail call for long line
+    {
+        r->status = INPUT_LONG;
+        return false;
+    }
+    STAT(lines, 1);
+    return true;
+}
+
+// Initialise policy for prompts
+static prompt_mode prompts = PROMPT_SHOW;
+
+// Set prompts of every function, resolving PROMPT_AUTO to showing prompts only if standard input is terminal
+// Return policy previously in use
+prompt_mode set_prompt_mode(prompt_mode mode)
+{
+    prompt_mode previous = prompts;
+    if (mode == PROMPT_AUTO)
+        mode = isatty(STDIN_FILENO) ? PROMPT_SHOW : PROMPT_SKIP;
+    prompts = mode;
+    return previous;
+}
+
+// Render formatted string with variadic arguments into buffer of rendered prompt
+// Return false on errors
+static bool render(rendering *r, const char *format, va_list *args)
+{
+    va_list ap;
+    va_copy(ap, *args); // Copy wrapper function arguments into variadic list
+    int n = vsnprintf(r->text, r->capacity, format, ap);
+    va_end(ap);
+
+    if (n < 0)
+        return false;
+
+    if ((size_t)n >= r->capacity) // Grow buffer and render again, considering terminating zero
+    {
+        char *temp = reserve(r->text, &r->capacity, (size_t)n + 1);
+        if (temp == NULL)
+            return false;
+        r->text = temp;
+
+        va_copy(ap, *args);
+        vsnprintf(r->text, r->capacity, format, ap);
+        va_end(ap);
+    }
+
+    r->size = (size_t)n;
+    return true;
+}
+
+// Prompt user using formatted string with variadic arguments of wrapper function
+// Write prompt rendered by first attempt again on retries, and skip prompt if prompts are off
+static void prompt(const char *format, va_list *args, bool retry)
+{
+    if (format == NULL || prompts == PROMPT_SKIP)
+        return;
+
+    if (strchr(format, '%') == NULL) // Write prompt without conversions as it is
+    {
+        fputs(format, stdout);
+        return;
+    }
+
+    local *l = own();
+    if (l != NULL && !retry)
+        l->cache.valid = render(&l->cache, format, args);
+
+    if (l != NULL && l->cache.valid)
+    {
+        fwrite(l->cache.text, 1, l->cache.size, stdout);
+        return;
+    }
+
+    va_list ap;
+    va_copy(ap, *args); // Format prompt directly if rendering fails
+    vprintf(format, ap);
+    va_end(ap);
+}
+
+// Prompt user, or write rendered prompt again on retry, and read line from reader for typed wrapper functions
+// End line at first '\0' like string from get_string function
+// Return false on errors or no input (EOF)
+static bool read_view(reader *r, const char *format, va_list *args, bool retry, line_view *view)
+{
+    if (retry && r->counted && r->attempts++ >= r->retries) // Give up after last retry
+    {
+        r->status = INPUT_EXHAUSTED;
+        return false;
+    }
+
+    prompt(format, args, retry);
+
+    if (!view_line(r, view))
+        return false;
+
+    const char *zero = memchr(view->data, '\0', view->size);
+    if (zero != NULL)
+        view->size = zero - view->data;
+    return true;
+}
+
+// Copy characters into scratch buffer of reader and terminate them with '\0'
+// Return copy without allocating once scratch buffer has grown, valid until next copy, or NULL on errors
+static char *terminate(reader *r, const char *str, size_t size)
+{
+    char *temp = reserve(r->scratch, &r->room, size + 1); // Consider terminating zero
+    if (temp == NULL)
+        return NULL;
+    r->scratch = temp;
+
+    memcpy(r->scratch, str, size);
+    r->scratch[size] = '\0';
+    return r->scratch;
+}
+
+// Check for whitespace like isspace(3) in C locale
+static inline bool blank(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Convert 8 decimal digits at once if bytes are all digits
+// Return false if any byte is not digit
+static inline bool eight_digits(const char *str, uint64_t *value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t word;
+    memcpy(&word, str, 8);
+
+    // Check high nibble is 3 and low nibble is at most 9 in every byte
+    if ((word & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+        ((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL)
+        return false;
+
+    // Combine digits in pairs, then quads, then all 8
+    word -= 0x3030303030303030ULL;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+            ((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    *value = word;
+    return true;
+#else
+    uint64_t result = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+            return false;
+        result = result * 10 + (str[i] - '0');
+    }
+    *value = result;
+    return true;
+#endif
+}
+
+// Parse decimal integer with optional sign, surrounded by optional whitespace, like strtoull(3) with base 10
+// Reject '-' if negative values are not allowed
+// Store magnitude and sign, and return INPUT_SYNTAX on invalid characters or INPUT_RANGE on magnitude beyond ULLONG_MAX or '-'
+static inline input_status parse_integer(const char *str, size_t size, bool sign, bool *negative, unsigned long long *magnitude)
+{
+    const char *end = str + size;
+
+    while (str < end && blank(*str)) // Trim leading whitespace
+        str++;
+    while (end > str && blank(end[-1])) // Trim trailing whitespace
+        end--;
+
+    *negative = false;
+    if (str < end && (*str == '+' || *str == '-'))
+        *negative = *str++ == '-';
+
+    if (str == end) // Check for missing digits
+        return INPUT_SYNTAX;
+
+    while (end - str > 1 && *str == '0') // Skip leading zeros
+        str++;
+
+    size_t digits = end - str;
+    if (digits > 20) // Check for more digits than ULLONG_MAX, reporting invalid characters first
+    {
+        for (; str < end; str++)
+            if (*str < '0' || *str > '9')
+                return INPUT_SYNTAX;
+        return INPUT_RANGE;
+    }
+
+    // Convert up to 19 digits, which cannot overflow, 8 digits at a time
+    uint64_t value = 0, chunk;
+    size_t safe = digits < 20 ? digits : 19;
+    for (; safe >= 8; safe -= 8, str += 8)
+    {
+        if (!eight_digits(str, &chunk))
+            return INPUT_SYNTAX;
+        value = value * 100000000 + chunk;
+    }
+    for (; safe > 0; safe--, str++)
+    {
+        if (*str < '0' || *str > '9')
+            return INPUT_SYNTAX;
+        value = value * 10 + (*str - '0');
+    }
+
+    if (str < end) // Convert 20th digit with overflow check
+    {
+        unsigned digit = (unsigned char)*str - '0';
+        if (digit > 9)
+            return INPUT_SYNTAX;
+        if (value > (ULLONG_MAX - digit) / 10)
+            return INPUT_RANGE;
+        value = value * 10 + digit;
+    }
+
+    if (*negative && !sign) // Reject negative value, once digits are valid
+        return INPUT_RANGE;
+
+    *magnitude = value;
+    return INPUT_OK;
+}
+
+// Parse signed decimal integer in [min, max]
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters or INPUT_RANGE on out of range value
+static inline input_status parse_signed(const char *str, size_t size, long long min, long long max, long long *value)
+{
+    bool negative;
+    unsigned long long magnitude;
+    input_status status = parse_integer(str, size, true, &negative, &magnitude);
+    if (status != INPUT_OK)
+        return status;
+
+    if (!negative)
+    {
+        if (magnitude > (unsigned long long)max)
+            return INPUT_RANGE;
+        *value = (long long)magnitude;
+        return INPUT_OK;
+    }
+
+    if (magnitude == 0)
+    {
+        *value = 0;
+        return INPUT_OK;
+    }
+
+    if (magnitude - 1 > (unsigned long long)-(min + 1)) // Compare without overflow at LLONG_MIN
+        return INPUT_RANGE;
+    *value = -(long long)(magnitude - 1) - 1;
+    return INPUT_OK;
+}
+
+// Parse unsigned decimal integer in [0, max], rejecting '-'
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters or INPUT_RANGE on out of range value
+static inline input_status parse_unsigned(const char *str, size_t size, unsigned long long max, unsigned long long *value)
+{
+    bool negative;
+    unsigned long long magnitude;
+    input_status status = parse_integer(str, size, false, &negative, &magnitude);
+    if (status != INPUT_OK)
+        return status;
+
+    if (magnitude > max)
+        return INPUT_RANGE;
+    *value = magnitude;
+    return INPUT_OK;
+}
+
+// Define macros for exact fast path of floating-point parsers (Clinger's algorithm)
+// Significand and power of 10 are both exact in type, so one multiplication or division rounds correctly
+// Require arithmetic in precision of type, which excludes x87 FPU evaluation of float and double
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define FAST_FLOAT
+#endif
+#if LDBL_MANT_DIG >= 64
+#define LDBL_FAST_MANTISSA UINT64_MAX
+#define LDBL_FAST_EXPONENT 27
+#else
+#define LDBL_FAST_MANTISSA (1ULL << 53)
+#define LDBL_FAST_EXPONENT 22
+#endif
+
+// Initialise exact powers of 10 for fast path of floating-point parsers
+static const float float_powers[] = {1e0F, 1e1F, 1e2F, 1e3F, 1e4F, 1e5F, 1e6F, 1e7F, 1e8F, 1e9F, 1e10F};
+static const double double_powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+static const long double long_double_powers[] = {1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L,
+                                                 1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L,
+                                                 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L};
+
+// Define macro for Eisel-Lemire path of double parser, which needs 128-bit product
+#if defined(FAST_FLOAT) && defined(__SIZEOF_INT128__)
+#define EISEL_LEMIRE
+__extension__ typedef unsigned __int128 uint128_t; // Keep 128-bit type quiet in ISO C pedantic builds
+
+// Initialise 128 most significant bits of powers of 5 from 5^-342 to 5^308, rounded up for negative powers
+static const uint64_t double_powers_128[][2] = {
+    {0xeef453d6923bd65a, 0x113faa2906a13b3f}, {0x9558b4661b6565f8, 0x4ac7ca59a424c507},
+    {0xbaaee17fa23ebf76, 0x5d79bcf00d2df649}, {0xe95a99df8ace6f53, 0xf4d82c2c107973dc},
+    {0x91d8a02bb6c10594, 0x79071b9b8a4be869}, {0xb64ec836a47146f9, 0x9748e2826cdee284},
+    {0xe3e27a444d8d98b7, 0xfd1b1b2308169b25}, {0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7},
+    {0xb208ef855c969f4f, 0xbdbd2d335e51a935}, {0xde8b2b66b3bc4723, 0xad2c788035e61382},
+    {0x8b16fb203055ac76, 0x4c3bcb5021afcc31}, {0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d},
+    {0xd953e8624b85dd78, 0xd71d6dad34a2af0d}, {0x87d4713d6f33aa6b, 0x8672648c40e5ad68},
+    {0xa9c98d8ccb009506, 0x680efdaf511f18c2}, {0xd43bf0effdc0ba48, 0x0212bd1b2566def2},
+    {0x84a57695fe98746d, 0x014bb630f7604b57}, {0xa5ced43b7e3e9188, 0x419ea3bd35385e2d},
+    {0xcf42894a5dce35ea, 0x52064cac828675b9}, {0x818995ce7aa0e1b2, 0x7343efebd1940993},
+    {0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8}, {0xca66fa129f9b60a6, 0xd41a26e077774ef6},
+    {0xfd00b897478238d0, 0x8920b098955522b4}, {0x9e20735e8cb16382, 0x55b46e5f5d5535b0},
+    {0xc5a890362fddbc62, 0xeb2189f734aa831d}, {0xf712b443bbd52b7b, 0xa5e9ec7501d523e4},
+    {0x9a6bb0aa55653b2d, 0x47b233c92125366e}, {0xc1069cd4eabe89f8, 0x999ec0bb696e840a},
+    {0xf148440a256e2c76, 0xc00670ea43ca250d}, {0x96cd2a865764dbca, 0x380406926a5e5728},
+    {0xbc807527ed3e12bc, 0xc605083704f5ecf2}, {0xeba09271e88d976b, 0xf7864a44c633682e},
+    {0x93445b8731587ea3, 0x7ab3ee6afbe0211d}, {0xb8157268fdae9e4c, 0x5960ea05bad82964},
+    {0xe61acf033d1a45df, 0x6fb92487298e33bd}, {0x8fd0c16206306bab, 0xa5d3b6d479f8e056},
+    {0xb3c4f1ba87bc8696, 0x8f48a4899877186c}, {0xe0b62e2929aba83c, 0x331acdabfe94de87},
+    {0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14}, {0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9},
+    {0xdb71e91432b1a24a, 0xc9e82cd9f69d6150}, {0x892731ac9faf056e, 0xbe311c083a225cd2},
+    {0xab70fe17c79ac6ca, 0x6dbd630a48aaf406}, {0xd64d3d9db981787d, 0x092cbbccdad5b108},
+    {0x85f0468293f0eb4e, 0x25bbf56008c58ea5}, {0xa76c582338ed2621, 0xaf2af2b80af6f24e},
+    {0xd1476e2c07286faa, 0x1af5af660db4aee1}, {0x82cca4db847945ca, 0x50d98d9fc890ed4d},
+    {0xa37fce126597973c, 0xe50ff107bab528a0}, {0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8},
+    {0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a}, {0x9faacf3df73609b1, 0x77b191618c54e9ac},
+    {0xc795830d75038c1d, 0xd59df5b9ef6a2417}, {0xf97ae3d0d2446f25, 0x4b0573286b44ad1d},
+    {0x9becce62836ac577, 0x4ee367f9430aec32}, {0xc2e801fb244576d5, 0x229c41f793cda73f},
+    {0xf3a20279ed56d48a, 0x6b43527578c1110f}, {0x9845418c345644d6, 0x830a13896b78aaa9},
+    {0xbe5691ef416bd60c, 0x23cc986bc656d553}, {0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8},
+    {0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9}, {0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53},
+    {0xe858ad248f5c22c9, 0xd1b3400f8f9cff68}, {0x91376c36d99995be, 0x23100809b9c21fa1},
+    {0xb58547448ffffb2d, 0xabd40a0c2832a78a}, {0xe2e69915b3fff9f9, 0x16c90c8f323f516c},
+    {0x8dd01fad907ffc3b, 0xae3da7d97f6792e3}, {0xb1442798f49ffb4a, 0x99cd11cfdf41779c},
+    {0xdd95317f31c7fa1d, 0x40405643d711d583}, {0x8a7d3eef7f1cfc52, 0x482835ea666b2572},
+    {0xad1c8eab5ee43b66, 0xda3243650005eecf}, {0xd863b256369d4a40, 0x90bed43e40076a82},
+    {0x873e4f75e2224e68, 0x5a7744a6e804a291}, {0xa90de3535aaae202, 0x711515d0a205cb36},
+    {0xd3515c2831559a83, 0x0d5a5b44ca873e03}, {0x8412d9991ed58091, 0xe858790afe9486c2},
+    {0xa5178fff668ae0b6, 0x626e974dbe39a872}, {0xce5d73ff402d98e3, 0xfb0a3d212dc8128f},
+    {0x80fa687f881c7f8e, 0x7ce66634bc9d0b99}, {0xa139029f6a239f72, 0x1c1fffc1ebc44e80},
+    {0xc987434744ac874e, 0xa327ffb266b56220}, {0xfbe9141915d7a922, 0x4bf1ff9f0062baa8},
+    {0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9}, {0xc4ce17b399107c22, 0xcb550fb4384d21d3},
+    {0xf6019da07f549b2b, 0x7e2a53a146606a48}, {0x99c102844f94e0fb, 0x2eda7444cbfc426d},
+    {0xc0314325637a1939, 0xfa911155fefb5308}, {0xf03d93eebc589f88, 0x793555ab7eba27ca},
+    {0x96267c7535b763b5, 0x4bc1558b2f3458de}, {0xbbb01b9283253ca2, 0x9eb1aaedfb016f16},
+    {0xea9c227723ee8bcb, 0x465e15a979c1cadc}, {0x92a1958a7675175f, 0x0bfacd89ec191ec9},
+    {0xb749faed14125d36, 0xcef980ec671f667b}, {0xe51c79a85916f484, 0x82b7e12780e7401a},
+    {0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810}, {0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15},
+    {0xdfbdcece67006ac9, 0x67a791e093e1d49a}, {0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0},
+    {0xaecc49914078536d, 0x58fae9f773886e18}, {0xda7f5bf590966848, 0xaf39a475506a899e},
+    {0x888f99797a5e012d, 0x6d8406c952429603}, {0xaab37fd7d8f58178, 0xc8e5087ba6d33b83},
+    {0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64}, {0x855c3be0a17fcd26, 0x5cf2eea09a55067f},
+    {0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e}, {0xd0601d8efc57b08b, 0xf13b94daf124da26},
+    {0x823c12795db6ce57, 0x76c53d08d6b70858}, {0xa2cb1717b52481ed, 0x54768c4b0c64ca6e},
+    {0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09}, {0xfe5d54150b090b02, 0xd3f93b35435d7c4c},
+    {0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf}, {0xc6b8e9b0709f109a, 0x359ab6419ca1091b},
+    {0xf867241c8cc6d4c0, 0xc30163d203c94b62}, {0x9b407691d7fc44f8, 0x79e0de63425dcf1d},
+    {0xc21094364dfb5636, 0x985915fc12f542e4}, {0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d},
+    {0x979cf3ca6cec5b5a, 0xa705992ceecf9c42}, {0xbd8430bd08277231, 0x50c6ff782a838353},
+    {0xece53cec4a314ebd, 0xa4f8bf5635246428}, {0x940f4613ae5ed136, 0x871b7795e136be99},
+    {0xb913179899f68584, 0x28e2557b59846e3f}, {0xe757dd7ec07426e5, 0x331aeada2fe589cf},
+    {0x9096ea6f3848984f, 0x3ff0d2c85def7621}, {0xb4bca50b065abe63, 0x0fed077a756b53a9},
+    {0xe1ebce4dc7f16dfb, 0xd3e8495912c62894}, {0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c},
+    {0xb080392cc4349dec, 0xbd8d794d96aacfb3}, {0xdca04777f541c567, 0xecf0d7a0fc5583a0},
+    {0x89e42caaf9491b60, 0xf41686c49db57244}, {0xac5d37d5b79b6239, 0x311c2875c522ced5},
+    {0xd77485cb25823ac7, 0x7d633293366b828b}, {0x86a8d39ef77164bc, 0xae5dff9c02033197},
+    {0xa8530886b54dbdeb, 0xd9f57f830283fdfc}, {0xd267caa862a12d66, 0xd072df63c324fd7b},
+    {0x8380dea93da4bc60, 0x4247cb9e59f71e6d}, {0xa46116538d0deb78, 0x52d9be85f074e608},
+    {0xcd795be870516656, 0x67902e276c921f8b}, {0x806bd9714632dff6, 0x00ba1cd8a3db53b6},
+    {0xa086cfcd97bf97f3, 0x80e8a40eccd228a4}, {0xc8a883c0fdaf7df0, 0x6122cd128006b2cd},
+    {0xfad2a4b13d1b5d6c, 0x796b805720085f81}, {0x9cc3a6eec6311a63, 0xcbe3303674053bb0},
+    {0xc3f490aa77bd60fc, 0xbedbfc4411068a9c}, {0xf4f1b4d515acb93b, 0xee92fb5515482d44},
+    {0x991711052d8bf3c5, 0x751bdd152d4d1c4a}, {0xbf5cd54678eef0b6, 0xd262d45a78a0635d},
+    {0xef340a98172aace4, 0x86fb897116c87c34}, {0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0},
+    {0xbae0a846d2195712, 0x8974836059cca109}, {0xe998d258869facd7, 0x2bd1a438703fc94b},
+    {0x91ff83775423cc06, 0x7b6306a34627ddcf}, {0xb67f6455292cbf08, 0x1a3bc84c17b1d542},
+    {0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93}, {0x8e938662882af53e, 0x547eb47b7282ee9c},
+    {0xb23867fb2a35b28d, 0xe99e619a4f23aa43}, {0xdec681f9f4c31f31, 0x6405fa00e2ec94d4},
+    {0x8b3c113c38f9f37e, 0xde83bc408dd3dd04}, {0xae0b158b4738705e, 0x9624ab50b148d445},
+    {0xd98ddaee19068c76, 0x3badd624dd9b0957}, {0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6},
+    {0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c}, {0xd47487cc8470652b, 0x7647c3200069671f},
+    {0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073}, {0xa5fb0a17c777cf09, 0xf468107100525890},
+    {0xcf79cc9db955c2cc, 0x7182148d4066eeb4}, {0x81ac1fe293d599bf, 0xc6f14cd848405530},
+    {0xa21727db38cb002f, 0xb8ada00e5a506a7c}, {0xca9cf1d206fdc03b, 0xa6d90811f0e4851c},
+    {0xfd442e4688bd304a, 0x908f4a166d1da663}, {0x9e4a9cec15763e2e, 0x9a598e4e043287fe},
+    {0xc5dd44271ad3cdba, 0x40eff1e1853f29fd}, {0xf7549530e188c128, 0xd12bee59e68ef47c},
+    {0x9a94dd3e8cf578b9, 0x82bb74f8301958ce}, {0xc13a148e3032d6e7, 0xe36a52363c1faf01},
+    {0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1}, {0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9},
+    {0xbcb2b812db11a5de, 0x7415d448f6b6f0e7}, {0xebdf661791d60f56, 0x111b495b3464ad21},
+    {0x936b9fcebb25c995, 0xcab10dd900beec34}, {0xb84687c269ef3bfb, 0x3d5d514f40eea742},
+    {0xe65829b3046b0afa, 0x0cb4a5a3112a5112}, {0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab},
+    {0xb3f4e093db73a093, 0x59ed216765690f56}, {0xe0f218b8d25088b8, 0x306869c13ec3532c},
+    {0x8c974f7383725573, 0x1e414218c73a13fb}, {0xafbd2350644eeacf, 0xe5d1929ef90898fa},
+    {0xdbac6c247d62a583, 0xdf45f746b74abf39}, {0x894bc396ce5da772, 0x6b8bba8c328eb783},
+    {0xab9eb47c81f5114f, 0x066ea92f3f326564}, {0xd686619ba27255a2, 0xc80a537b0efefebd},
+    {0x8613fd0145877585, 0xbd06742ce95f5f36}, {0xa798fc4196e952e7, 0x2c48113823b73704},
+    {0xd17f3b51fca3a7a0, 0xf75a15862ca504c5}, {0x82ef85133de648c4, 0x9a984d73dbe722fb},
+    {0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba}, {0xcc963fee10b7d1b3, 0x318df905079926a8},
+    {0xffbbcfe994e5c61f, 0xfdf17746497f7052}, {0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633},
+    {0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0}, {0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0},
+    {0x9c1661a651213e2d, 0x06bea10ca65c084e}, {0xc31bfa0fe5698db8, 0x486e494fcff30a62},
+    {0xf3e2f893dec3f126, 0x5a89dba3c3efccfa}, {0x986ddb5c6b3a76b7, 0xf89629465a75e01c},
+    {0xbe89523386091465, 0xf6bbb397f1135823}, {0xee2ba6c0678b597f, 0x746aa07ded582e2c},
+    {0x94db483840b717ef, 0xa8c2a44eb4571cdc}, {0xba121a4650e4ddeb, 0x92f34d62616ce413},
+    {0xe896a0d7e51e1566, 0x77b020baf9c81d17}, {0x915e2486ef32cd60, 0x0ace1474dc1d122e},
+    {0xb5b5ada8aaff80b8, 0x0d819992132456ba}, {0xe3231912d5bf60e6, 0x10e1fff697ed6c69},
+    {0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1}, {0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2},
+    {0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde}, {0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b},
+    {0xad4ab7112eb3929d, 0x86c16c98d2c953c6}, {0xd89d64d57a607744, 0xe871c7bf077ba8b7},
+    {0x87625f056c7c4a8b, 0x11471cd764ad4972}, {0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf},
+    {0xd389b47879823479, 0x4aff1d108d4ec2c3}, {0x843610cb4bf160cb, 0xcedf722a585139ba},
+    {0xa54394fe1eedb8fe, 0xc2974eb4ee658828}, {0xce947a3da6a9273e, 0x733d226229feea32},
+    {0x811ccc668829b887, 0x0806357d5a3f525f}, {0xa163ff802a3426a8, 0xca07c2dcb0cf26f7},
+    {0xc9bcff6034c13052, 0xfc89b393dd02f0b5}, {0xfc2c3f3841f17c67, 0xbbac2078d443ace2},
+    {0x9d9ba7832936edc0, 0xd54b944b84aa4c0d}, {0xc5029163f384a931, 0x0a9e795e65d4df11},
+    {0xf64335bcf065d37d, 0x4d4617b5ff4a16d5}, {0x99ea0196163fa42e, 0x504bced1bf8e4e45},
+    {0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6}, {0xf07da27a82c37088, 0x5d767327bb4e5a4c},
+    {0x964e858c91ba2655, 0x3a6a07f8d510f86f}, {0xbbe226efb628afea, 0x890489f70a55368b},
+    {0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e}, {0x92c8ae6b464fc96f, 0x3b0b8bc90012929d},
+    {0xb77ada0617e3bbcb, 0x09ce6ebb40173744}, {0xe55990879ddcaabd, 0xcc420a6a101d0515},
+    {0x8f57fa54c2a9eab6, 0x9fa946824a12232d}, {0xb32df8e9f3546564, 0x47939822dc96abf9},
+    {0xdff9772470297ebd, 0x59787e2b93bc56f7}, {0x8bfbea76c619ef36, 0x57eb4edb3c55b65a},
+    {0xaefae51477a06b03, 0xede622920b6b23f1}, {0xdab99e59958885c4, 0xe95fab368e45eced},
+    {0x88b402f7fd75539b, 0x11dbcb0218ebb414}, {0xaae103b5fcd2a881, 0xd652bdc29f26a119},
+    {0xd59944a37c0752a2, 0x4be76d3346f0495f}, {0x857fcae62d8493a5, 0x6f70a4400c562ddb},
+    {0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952}, {0xd097ad07a71f26b2, 0x7e2000a41346a7a7},
+    {0x825ecc24c873782f, 0x8ed400668c0c28c8}, {0xa2f67f2dfa90563b, 0x728900802f0f32fa},
+    {0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9}, {0xfea126b7d78186bc, 0xe2f610c84987bfa8},
+    {0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9}, {0xc6ede63fa05d3143, 0x91503d1c79720dbb},
+    {0xf8a95fcf88747d94, 0x75a44c6397ce912a}, {0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba},
+    {0xc24452da229b021b, 0xfbe85badce996168}, {0xf2d56790ab41c2a2, 0xfae27299423fb9c3},
+    {0x97c560ba6b0919a5, 0xdccd879fc967d41a}, {0xbdb6b8e905cb600f, 0x5400e987bbc1c920},
+    {0xed246723473e3813, 0x290123e9aab23b68}, {0x9436c0760c86e30b, 0xf9a0b6720aaf6521},
+    {0xb94470938fa89bce, 0xf808e40e8d5b3e69}, {0xe7958cb87392c2c2, 0xb60b1d1230b20e04},
+    {0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2}, {0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3},
+    {0xe2280b6c20dd5232, 0x25c6da63c38de1b0}, {0x8d590723948a535f, 0x579c487e5a38ad0e},
+    {0xb0af48ec79ace837, 0x2d835a9df0c6d851}, {0xdcdb1b2798182244, 0xf8e431456cf88e65},
+    {0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff}, {0xac8b2d36eed2dac5, 0xe272467e3d222f3f},
+    {0xd7adf884aa879177, 0x5b0ed81dcc6abb0f}, {0x86ccbb52ea94baea, 0x98e947129fc2b4e9},
+    {0xa87fea27a539e9a5, 0x3f2398d747b36224}, {0xd29fe4b18e88640e, 0x8eec7f0d19a03aad},
+    {0x83a3eeeef9153e89, 0x1953cf68300424ac}, {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7},
+    {0xcdb02555653131b6, 0x3792f412cb06794d}, {0x808e17555f3ebf11, 0xe2bbd88bbee40bd0},
+    {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4}, {0xc8de047564d20a8b, 0xf245825a5a445275},
+    {0xfb158592be068d2e, 0xeed6e2f0f0d56712}, {0x9ced737bb6c4183d, 0x55464dd69685606b},
+    {0xc428d05aa4751e4c, 0xaa97e14c3c26b886}, {0xf53304714d9265df, 0xd53dd99f4b3066a8},
+    {0x993fe2c6d07b7fab, 0xe546a8038efe4029}, {0xbf8fdb78849a5f96, 0xde98520472bdd033},
+    {0xef73d256a5c0f77c, 0x963e66858f6d4440}, {0x95a8637627989aad, 0xdde7001379a44aa8},
+    {0xbb127c53b17ec159, 0x5560c018580d5d52}, {0xe9d71b689dde71af, 0xaab8f01e6e10b4a6},
+    {0x9226712162ab070d, 0xcab3961304ca70e8}, {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22},
+    {0xe45c10c42a2b3b05, 0x8cb89a7db77c506a}, {0x8eb98a7a9a5b04e3, 0x77f3608e92adb242},
+    {0xb267ed1940f1c61c, 0x55f038b237591ed3}, {0xdf01e85f912e37a3, 0x6b6c46dec52f6688},
+    {0x8b61313bbabce2c6, 0x2323ac4b3b3da015}, {0xae397d8aa96c1b77, 0xabec975e0a0d081a},
+    {0xd9c7dced53c72255, 0x96e7bd358c904a21}, {0x881cea14545c7575, 0x7e50d64177da2e54},
+    {0xaa242499697392d2, 0xdde50bd1d5d0b9e9}, {0xd4ad2dbfc3d07787, 0x955e4ec64b44e864},
+    {0x84ec3c97da624ab4, 0xbd5af13bef0b113e}, {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e},
+    {0xcfb11ead453994ba, 0x67de18eda5814af2}, {0x81ceb32c4b43fcf4, 0x80eacf948770ced7},
+    {0xa2425ff75e14fc31, 0xa1258379a94d028d}, {0xcad2f7f5359a3b3e, 0x096ee45813a04330},
+    {0xfd87b5f28300ca0d, 0x8bca9d6e188853fc}, {0x9e74d1b791e07e48, 0x775ea264cf55347e},
+    {0xc612062576589dda, 0x95364afe032a819e}, {0xf79687aed3eec551, 0x3a83ddbd83f52205},
+    {0x9abe14cd44753b52, 0xc4926a9672793543}, {0xc16d9a0095928a27, 0x75b7053c0f178294},
+    {0xf1c90080baf72cb1, 0x5324c68b12dd6339}, {0x971da05074da7bee, 0xd3f6fc16ebca5e04},
+    {0xbce5086492111aea, 0x88f4bb1ca6bcf585}, {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6},
+    {0x9392ee8e921d5d07, 0x3aff322e62439fd0}, {0xb877aa3236a4b449, 0x09befeb9fad487c3},
+    {0xe69594bec44de15b, 0x4c2ebe687989a9b4}, {0x901d7cf73ab0acd9, 0x0f9d37014bf60a11},
+    {0xb424dc35095cd80f, 0x538484c19ef38c95}, {0xe12e13424bb40e13, 0x2865a5f206b06fba},
+    {0x8cbccc096f5088cb, 0xf93f87b7442e45d4}, {0xafebff0bcb24aafe, 0xf78f69a51539d749},
+    {0xdbe6fecebdedd5be, 0xb573440e5a884d1c}, {0x89705f4136b4a597, 0x31680a88f8953031},
+    {0xabcc77118461cefc, 0xfdc20d2b36ba7c3e}, {0xd6bf94d5e57a42bc, 0x3d32907604691b4d},
+    {0x8637bd05af6c69b5, 0xa63f9a49c2c1b110}, {0xa7c5ac471b478423, 0x0fcf80dc33721d54},
+    {0xd1b71758e219652b, 0xd3c36113404ea4a9}, {0x83126e978d4fdf3b, 0x645a1cac083126ea},
+    {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4}, {0xcccccccccccccccc, 0xcccccccccccccccd},
+    {0x8000000000000000, 0x0000000000000000}, {0xa000000000000000, 0x0000000000000000},
+    {0xc800000000000000, 0x0000000000000000}, {0xfa00000000000000, 0x0000000000000000},
+    {0x9c40000000000000, 0x0000000000000000}, {0xc350000000000000, 0x0000000000000000},
+    {0xf424000000000000, 0x0000000000000000}, {0x9896800000000000, 0x0000000000000000},
+    {0xbebc200000000000, 0x0000000000000000}, {0xee6b280000000000, 0x0000000000000000},
+    {0x9502f90000000000, 0x0000000000000000}, {0xba43b74000000000, 0x0000000000000000},
+    {0xe8d4a51000000000, 0x0000000000000000}, {0x9184e72a00000000, 0x0000000000000000},
+    {0xb5e620f480000000, 0x0000000000000000}, {0xe35fa931a0000000, 0x0000000000000000},
+    {0x8e1bc9bf04000000, 0x0000000000000000}, {0xb1a2bc2ec5000000, 0x0000000000000000},
+    {0xde0b6b3a76400000, 0x0000000000000000}, {0x8ac7230489e80000, 0x0000000000000000},
+    {0xad78ebc5ac620000, 0x0000000000000000}, {0xd8d726b7177a8000, 0x0000000000000000},
+    {0x878678326eac9000, 0x0000000000000000}, {0xa968163f0a57b400, 0x0000000000000000},
+    {0xd3c21bcecceda100, 0x0000000000000000}, {0x84595161401484a0, 0x0000000000000000},
+    {0xa56fa5b99019a5c8, 0x0000000000000000}, {0xcecb8f27f4200f3a, 0x0000000000000000},
+    {0x813f3978f8940984, 0x4000000000000000}, {0xa18f07d736b90be5, 0x5000000000000000},
+    {0xc9f2c9cd04674ede, 0xa400000000000000}, {0xfc6f7c4045812296, 0x4d00000000000000},
+    {0x9dc5ada82b70b59d, 0xf020000000000000}, {0xc5371912364ce305, 0x6c28000000000000},
+    {0xf684df56c3e01bc6, 0xc732000000000000}, {0x9a130b963a6c115c, 0x3c7f400000000000},
+    {0xc097ce7bc90715b3, 0x4b9f100000000000}, {0xf0bdc21abb48db20, 0x1e86d40000000000},
+    {0x96769950b50d88f4, 0x1314448000000000}, {0xbc143fa4e250eb31, 0x17d955a000000000},
+    {0xeb194f8e1ae525fd, 0x5dcfab0800000000}, {0x92efd1b8d0cf37be, 0x5aa1cae500000000},
+    {0xb7abc627050305ad, 0xf14a3d9e40000000}, {0xe596b7b0c643c719, 0x6d9ccd05d0000000},
+    {0x8f7e32ce7bea5c6f, 0xe4820023a2000000}, {0xb35dbf821ae4f38b, 0xdda2802c8a800000},
+    {0xe0352f62a19e306e, 0xd50b2037ad200000}, {0x8c213d9da502de45, 0x4526f422cc340000},
+    {0xaf298d050e4395d6, 0x9670b12b7f410000}, {0xdaf3f04651d47b4c, 0x3c0cdd765f114000},
+    {0x88d8762bf324cd0f, 0xa5880a69fb6ac800}, {0xab0e93b6efee0053, 0x8eea0d047a457a00},
+    {0xd5d238a4abe98068, 0x72a4904598d6d880}, {0x85a36366eb71f041, 0x47a6da2b7f864750},
+    {0xa70c3c40a64e6c51, 0x999090b65f67d924}, {0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},
+    {0x82818f1281ed449f, 0xbff8f10e7a8921a4}, {0xa321f2d7226895c7, 0xaff72d52192b6a0d},
+    {0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490}, {0xfee50b7025c36a08, 0x02f236d04753d5b4},
+    {0x9f4f2726179a2245, 0x01d762422c946590}, {0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5},
+    {0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2}, {0x9b934c3b330c8577, 0x63cc55f49f88eb2f},
+    {0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb}, {0xf316271c7fc3908a, 0x8bef464e3945ef7a},
+    {0x97edd871cfda3a56, 0x97758bf0e3cbb5ac}, {0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317},
+    {0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd}, {0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a},
+    {0xb975d6b6ee39e436, 0xb3e2fd538e122b44}, {0xe7d34c64a9c85d44, 0x60dbbca87196b616},
+    {0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd}, {0xb51d13aea4a488dd, 0x6babab6398bdbe41},
+    {0xe264589a4dcdab14, 0xc696963c7eed2dd1}, {0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2},
+    {0xb0de65388cc8ada8, 0x3b25a55f43294bcb}, {0xdd15fe86affad912, 0x49ef0eb713f39ebe},
+    {0x8a2dbf142dfcc7ab, 0x6e3569326c784337}, {0xacb92ed9397bf996, 0x49c2c37f07965404},
+    {0xd7e77a8f87daf7fb, 0xdc33745ec97be906}, {0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3},
+    {0xa8acd7c0222311bc, 0xc40832ea0d68ce0c}, {0xd2d80db02aabd62b, 0xf50a3fa490c30190},
+    {0x83c7088e1aab65db, 0x792667c6da79e0fa}, {0xa4b8cab1a1563f52, 0x577001b891185938},
+    {0xcde6fd5e09abcf26, 0xed4c0226b55e6f86}, {0x80b05e5ac60b6178, 0x544f8158315b05b4},
+    {0xa0dc75f1778e39d6, 0x696361ae3db1c721}, {0xc913936dd571c84c, 0x03bc3a19cd1e38e9},
+    {0xfb5878494ace3a5f, 0x04ab48a04065c723}, {0x9d174b2dcec0e47b, 0x62eb0d64283f9c76},
+    {0xc45d1df942711d9a, 0x3ba5d0bd324f8394}, {0xf5746577930d6500, 0xca8f44ec7ee36479},
+    {0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb}, {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e},
+    {0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e}, {0x95d04aee3b80ece5, 0xbba1f1d158724a12},
+    {0xbb445da9ca61281f, 0x2a8a6e45ae8edc97}, {0xea1575143cf97226, 0xf52d09d71a3293bd},
+    {0x924d692ca61be758, 0x593c2626705f9c56}, {0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c},
+    {0xe498f455c38b997a, 0x0b6dfb9c0f956447}, {0x8edf98b59a373fec, 0x4724bd4189bd5eac},
+    {0xb2977ee300c50fe7, 0x58edec91ec2cb657}, {0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed},
+    {0x8b865b215899f46c, 0xbd79e0d20082ee74}, {0xae67f1e9aec07187, 0xecd8590680a3aa11},
+    {0xda01ee641a708de9, 0xe80e6f4820cc9495}, {0x884134fe908658b2, 0x3109058d147fdcdd},
+    {0xaa51823e34a7eede, 0xbd4b46f0599fd415}, {0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a},
+    {0x850fadc09923329e, 0x03e2cf6bc604ddb0}, {0xa6539930bf6bff45, 0x84db8346b786151c},
+    {0xcfe87f7cef46ff16, 0xe612641865679a63}, {0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e},
+    {0xa26da3999aef7749, 0xe3be5e330f38f09d}, {0xcb090c8001ab551c, 0x5cadf5bfd3072cc5},
+    {0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6}, {0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa},
+    {0xc646d63501a1511d, 0xb281e1fd541501b8}, {0xf7d88bc24209a565, 0x1f225a7ca91a4226},
+    {0x9ae757596946075f, 0x3375788de9b06958}, {0xc1a12d2fc3978937, 0x0052d6b1641c83ae},
+    {0xf209787bb47d6b84, 0xc0678c5dbd23a49a}, {0x9745eb4d50ce6332, 0xf840b7ba963646e0},
+    {0xbd176620a501fbff, 0xb650e5a93bc3d898}, {0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe},
+    {0x93ba47c980e98cdf, 0xc66f336c36b10137}, {0xb8a8d9bbe123f017, 0xb80b0047445d4184},
+    {0xe6d3102ad96cec1d, 0xa60dc059157491e5}, {0x9043ea1ac7e41392, 0x87c89837ad68db2f},
+    {0xb454e4a179dd1877, 0x29babe4598c311fb}, {0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a},
+    {0x8ce2529e2734bb1d, 0x1899e4a65f58660c}, {0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f},
+    {0xdc21a1171d42645d, 0x76707543f4fa1f73}, {0x899504ae72497eba, 0x6a06494a791c53a8},
+    {0xabfa45da0edbde69, 0x0487db9d17636892}, {0xd6f8d7509292d603, 0x45a9d2845d3c42b6},
+    {0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2}, {0xa7f26836f282b732, 0x8e6cac7768d7141e},
+    {0xd1ef0244af2364ff, 0x3207d795430cd926}, {0x8335616aed761f1f, 0x7f44e6bd49e807b8},
+    {0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6}, {0xcd036837130890a1, 0x36dba887c37a8c0f},
+    {0x802221226be55a64, 0xc2494954da2c9789}, {0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c},
+    {0xc83553c5c8965d3d, 0x6f92829494e5acc7}, {0xfa42a8b73abbf48c, 0xcb772339ba1f17f9},
+    {0x9c69a97284b578d7, 0xff2a760414536efb}, {0xc38413cf25e2d70d, 0xfef5138519684aba},
+    {0xf46518c2ef5b8cd1, 0x7eb258665fc25d69}, {0x98bf2f79d5993802, 0xef2f773ffbd97a61},
+    {0xbeeefb584aff8603, 0xaafb550ffacfd8fa}, {0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38},
+    {0x952ab45cfa97a0b2, 0xdd945a747bf26183}, {0xba756174393d88df, 0x94f971119aeef9e4},
+    {0xe912b9d1478ceb17, 0x7a37cd5601aab85d}, {0x91abb422ccb812ee, 0xac62e055c10ab33a},
+    {0xb616a12b7fe617aa, 0x577b986b314d6009}, {0xe39c49765fdf9d94, 0xed5a7e85fda0b80b},
+    {0x8e41ade9fbebc27d, 0x14588f13be847307}, {0xb1d219647ae6b31c, 0x596eb2d8ae258fc8},
+    {0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb}, {0x8aec23d680043bee, 0x25de7bb9480d5854},
+    {0xada72ccc20054ae9, 0xaf561aa79a10ae6a}, {0xd910f7ff28069da4, 0x1b2ba1518094da04},
+    {0x87aa9aff79042286, 0x90fb44d2f05d0842}, {0xa99541bf57452b28, 0x353a1607ac744a53},
+    {0xd3fa922f2d1675f2, 0x42889b8997915ce8}, {0x847c9b5d7c2e09b7, 0x69956135febada11},
+    {0xa59bc234db398c25, 0x43fab9837e699095}, {0xcf02b2c21207ef2e, 0x94f967e45e03f4bb},
+    {0x8161afb94b44f57d, 0x1d1be0eebac278f5}, {0xa1ba1ba79e1632dc, 0x6462d92a69731732},
+    {0xca28a291859bbf93, 0x7d7b8f7503cfdcfe}, {0xfcb2cb35e702af78, 0x5cda735244c3d43e},
+    {0x9defbf01b061adab, 0x3a0888136afa64a7}, {0xc56baec21c7a1916, 0x088aaa1845b8fdd0},
+    {0xf6c69a72a3989f5b, 0x8aad549e57273d45}, {0x9a3c2087a63f6399, 0x36ac54e2f678864b},
+    {0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd}, {0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5},
+    {0x969eb7c47859e743, 0x9f644ae5a4b1b325}, {0xbc4665b596706114, 0x873d5d9f0dde1fee},
+    {0xeb57ff22fc0c7959, 0xa90cb506d155a7ea}, {0x9316ff75dd87cbd8, 0x09a7f12442d588f2},
+    {0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f}, {0xe5d3ef282a242e81, 0x8f1668c8a86da5fa},
+    {0x8fa475791a569d10, 0xf96e017d694487bc}, {0xb38d92d760ec4455, 0x37c981dcc395a9ac},
+    {0xe070f78d3927556a, 0x85bbe253f47b1417}, {0x8c469ab843b89562, 0x93956d7478ccec8e},
+    {0xaf58416654a6babb, 0x387ac8d1970027b2}, {0xdb2e51bfe9d0696a, 0x06997b05fcc0319e},
+    {0x88fcf317f22241e2, 0x441fece3bdf81f03}, {0xab3c2fddeeaad25a, 0xd527e81cad7626c3},
+    {0xd60b3bd56a5586f1, 0x8a71e223d8d3b074}, {0x85c7056562757456, 0xf6872d5667844e49},
+    {0xa738c6bebb12d16c, 0xb428f8ac016561db}, {0xd106f86e69d785c7, 0xe13336d701beba52},
+    {0x82a45b450226b39c, 0xecc0024661173473}, {0xa34d721642b06084, 0x27f002d7f95d0190},
+    {0xcc20ce9bd35c78a5, 0x31ec038df7b441f4}, {0xff290242c83396ce, 0x7e67047175a15271},
+    {0x9f79a169bd203e41, 0x0f0062c6e984d386}, {0xc75809c42c684dd1, 0x52c07b78a3e60868},
+    {0xf92e0c3537826145, 0xa7709a56ccdf8a82}, {0x9bbcc7a142b17ccb, 0x88a66076400bb691},
+    {0xc2abf989935ddbfe, 0x6acff893d00ea435}, {0xf356f7ebf83552fe, 0x0583f6b8c4124d43},
+    {0x98165af37b2153de, 0xc3727a337a8b704a}, {0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c},
+    {0xeda2ee1c7064130c, 0x1162def06f79df73}, {0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8},
+    {0xb9a74a0637ce2ee1, 0x6d953e2bd7173692}, {0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437},
+    {0x910ab1d4db9914a0, 0x1d9c9892400a22a2}, {0xb54d5e4a127f59c8, 0x2503beb6d00cab4b},
+    {0xe2a0b5dc971f303a, 0x2e44ae64840fd61d}, {0x8da471a9de737e24, 0x5ceaecfed289e5d2},
+    {0xb10d8e1456105dad, 0x7425a83e872c5f47}, {0xdd50f1996b947518, 0xd12f124e28f77719},
+    {0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f}, {0xace73cbfdc0bfb7b, 0x636cc64d1001550b},
+    {0xd8210befd30efa5a, 0x3c47f7e05401aa4e}, {0x8714a775e3e95c78, 0x65acfaec34810a71},
+    {0xa8d9d1535ce3b396, 0x7f1839a741a14d0d}, {0xd31045a8341ca07c, 0x1ede48111209a050},
+    {0x83ea2b892091e44d, 0x934aed0aab460432}, {0xa4e4b66b68b65d60, 0xf81da84d5617853f},
+    {0xce1de40642e3f4b9, 0x36251260ab9d668e}, {0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019},
+    {0xa1075a24e4421730, 0xb24cf65b8612f81f}, {0xc94930ae1d529cfc, 0xdee033f26797b627},
+    {0xfb9b7cd9a4a7443c, 0x169840ef017da3b1}, {0x9d412e0806e88aa5, 0x8e1f289560ee864e},
+    {0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2}, {0xf5b5d7ec8acb58a2, 0xae10af696774b1db},
+    {0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29}, {0xbff610b0cc6edd3f, 0x17fd090a58d32af3},
+    {0xeff394dcff8a948e, 0xddfc4b4cef07f5b0}, {0x95f83d0a1fb69cd9, 0x4abdaf101564f98e},
+    {0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1}, {0xea53df5fd18d5513, 0x84c86189216dc5ed},
+    {0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4}, {0xb7118682dbb66a77, 0x3fbc8c33221dc2a1},
+    {0xe4d5e82392a40515, 0x0fabaf3feaa5334a}, {0x8f05b1163ba6832d, 0x29cb4d87f2a7400e},
+    {0xb2c71d5bca9023f8, 0x743e20e9ef511012}, {0xdf78e4b2bd342cf6, 0x914da9246b255416},
+    {0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e}, {0xae9672aba3d0c320, 0xa184ac2473b529b1},
+    {0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e}, {0x8865899617fb1871, 0x7e2fa67c7a658892},
+    {0xaa7eebfb9df9de8d, 0xddbb901b98feeab7}, {0xd51ea6fa85785631, 0x552a74227f3ea565},
+    {0x8533285c936b35de, 0xd53a88958f87275f}, {0xa67ff273b8460356, 0x8a892abaf368f137},
+    {0xd01fef10a657842c, 0x2d2b7569b0432d85}, {0x8213f56a67f6b29b, 0x9c3b29620e29fc73},
+    {0xa298f2c501f45f42, 0x8349f3ba91b47b8f}, {0xcb3f2f7642717713, 0x241c70a936219a73},
+    {0xfe0efb53d30dd4d7, 0xed238cd383aa0110}, {0x9ec95d1463e8a506, 0xf4363804324a40aa},
+    {0xc67bb4597ce2ce48, 0xb143c6053edcd0d5}, {0xf81aa16fdc1b81da, 0xdd94b7868e94050a},
+    {0x9b10a4e5e9913128, 0xca7cf2b4191c8326}, {0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0},
+    {0xf24a01a73cf2dccf, 0xbc633b39673c8cec}, {0x976e41088617ca01, 0xd5be0503e085d813},
+    {0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18}, {0xec9c459d51852ba2, 0xddf8e7d60ed1219e},
+    {0x93e1ab8252f33b45, 0xcabb90e5c942b503}, {0xb8da1662e7b00a17, 0x3d6a751f3b936243},
+    {0xe7109bfba19c0c9d, 0x0cc512670a783ad4}, {0x906a617d450187e2, 0x27fb2b80668b24c5},
+    {0xb484f9dc9641e9da, 0xb1f9f660802dedf6}, {0xe1a63853bbd26451, 0x5e7873f8a0396973},
+    {0x8d07e33455637eb2, 0xdb0b487b6423e1e8}, {0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62},
+    {0xdc5c5301c56b75f7, 0x7641a140cc7810fb}, {0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d},
+    {0xac2820d9623bf429, 0x546345fa9fbdcd44}, {0xd732290fbacaf133, 0xa97c177947ad4095},
+    {0x867f59a9d4bed6c0, 0x49ed8eabcccc485d}, {0xa81f301449ee8c70, 0x5c68f256bfff5a74},
+    {0xd226fc195c6a2f8c, 0x73832eec6fff3111}, {0x83585d8fd9c25db7, 0xc831fd53c5ff7eab},
+    {0xa42e74f3d032f525, 0xba3e7ca8b77f5e55}, {0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb},
+    {0x80444b5e7aa7cf85, 0x7980d163cf5b81b3}, {0xa0555e361951c366, 0xd7e105bcc332621f},
+    {0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7}, {0xfa856334878fc150, 0xb14f98f6f0feb951},
+    {0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3}, {0xc3b8358109e84f07, 0x0a862f80ec4700c8},
+    {0xf4a642e14c6262c8, 0xcd27bb612758c0fa}, {0x98e7e9cccfbd7dbd, 0x8038d51cb897789c},
+    {0xbf21e44003acdd2c, 0xe0470a63e6bd56c3}, {0xeeea5d5004981478, 0x1858ccfce06cac74},
+    {0x95527a5202df0ccb, 0x0f37801e0c43ebc8}, {0xbaa718e68396cffd, 0xd30560258f54e6ba},
+    {0xe950df20247c83fd, 0x47c6b82ef32a2069}, {0x91d28b7416cdd27e, 0x4cdc331d57fa5441},
+    {0xb6472e511c81471d, 0xe0133fe4adf8e952}, {0xe3d8f9e563a198e5, 0x58180fddd97723a6},
+    {0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648}
+};
+
+// Convert significand of up to 19 digits and power of 10 to nearest double (Eisel-Lemire algorithm)
+// Multiply significand by truncated power of 5, whose error cannot change rounding unless low bits are all ones
+// Return false for subnormal, overflowing, or ambiguous product, which strtod(3) handles
+static inline bool parse_binary64(uint64_t mantissa, long exponent, double *value)
+{
+    if (mantissa == 0)
+    {
+        *value = 0;
+        return true;
+    }
+    if (exponent < -342 || exponent > 308)
+        return false;
+
+    int zeros = __builtin_clzll(mantissa);
+    mantissa <<= zeros;
+    const uint64_t *power = double_powers_128[exponent + 342];
+    uint128_t product = (uint128_t)mantissa * power[0];
+    uint64_t high = (uint64_t)(product >> 64), low = (uint64_t)product;
+    if ((high & 0x1FF) == 0x1FF) // Add product with low half of power when bits below 55 bits kept may carry
+    {
+        uint64_t carry = (uint64_t)(((uint128_t)mantissa * power[1]) >> 64);
+        low += carry;
+        high += low < carry;
+    }
+    if (low == UINT64_MAX && (exponent < -27 || exponent > 55)) // Check for product too close to tell rounding
+        return false;
+
+    // Keep 54 bits, then round half to even, where exact halfway products exist only for small powers
+    int upper = (int)(high >> 63);
+    uint64_t bits = high >> (upper + 9);
+    long biased = ((217706 * exponent) >> 16) + 63 + upper - zeros + 1023;
+    if (biased <= 0)
+        return false;
+    if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 && bits << (upper + 9) == high)
+        bits &= ~(uint64_t)1;
+    bits = (bits + (bits & 1)) >> 1;
+    if (bits >= (2ULL << 52)) // Carry rounding into exponent
+    {
+        bits = 1ULL << 52;
+        biased++;
+    }
+    if (biased >= 0x7FF)
+        return false;
+
+    bits = (bits & ~(1ULL << 52)) | (uint64_t)biased << 52;
+    memcpy(value, &bits, sizeof(*value));
+    return true;
+}
+#endif
+
+// Parse decimal number with optional sign, fraction, and exponent, surrounded by optional whitespace
+// Store sign, significand of up to 19 digits, and power of 10
+// Return false for any other input (hexadecimal, inf, nan, more digits, errors), which strtod(3) family handles
+static inline bool parse_decimal(const char *str, size_t size, bool *negative, uint64_t *mantissa, long *exponent)
+{
+    const char *end = str + size;
+
+    while (str < end && blank(*str)) // Trim leading whitespace
+        str++;
+    while (end > str && blank(end[-1])) // Trim trailing whitespace
+        end--;
+
+    *negative = false;
+    if (str < end && (*str == '+' || *str == '-'))
+        *negative = *str++ == '-';
+
+    uint64_t value = 0;
+    long power = 0;
+    int digits = 0;    // Number of significant digits
+    bool any = false;  // Indicate at least one digit
+
+    while (str < end && *str == '0') // Skip leading zeros of integer part
+    {
+        str++;
+        any = true;
+    }
+    for (; str < end && *str >= '0' && *str <= '9'; str++, any = true) // Convert integer part
+    {
+        if (++digits > 19)
+            return false;
+        value = value * 10 + (*str - '0');
+    }
+
+    if (str < end && *str == '.')
+    {
+        str++;
+        if (digits == 0) // Skip leading zeros of fraction
+            for (; str < end && *str == '0'; str++, power--)
+                any = true;
+        for (; str < end && *str >= '0' && *str <= '9'; str++, power--, any = true) // Convert fraction
+        {
+            if (++digits > 19)
+                return false;
+            value = value * 10 + (*str - '0');
+        }
+    }
+
+    if (!any) // Check for missing digits
+        return false;
+
+    if (str < end && (*str == 'e' || *str == 'E'))
+    {
+        str++;
+        bool minus = false;
+        if (str < end && (*str == '+' || *str == '-'))
+            minus = *str++ == '-';
+
+        if (str == end) // Check for missing exponent digits
+            return false;
+
+        long e = 0;
+        for (; str < end && *str >= '0' && *str <= '9'; str++)
+            if (e < 100000) // Saturate exponent far beyond any type
+                e = e * 10 + (*str - '0');
+        power += minus ? -e : e;
+    }
+
+    if (str != end) // Check remaining characters
+        return false;
+
+    *mantissa = value;
+    *exponent = power;
+    return true;
+}
+
+// Parse float in [-FLT_MAX, FLT_MAX] like strtof(3), rejecting inf, nan, and subnormal numbers
+// Use exact fast path if possible, otherwise copy characters into scratch buffer of reader for strtof(3)
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters, INPUT_RANGE on out of range value, or INPUT_ALLOC on errors
+static input_status parse_float(reader *r, const char *str, size_t size, float *value)
+{
+#ifdef FAST_FLOAT
+    bool negative;
+    uint64_t mantissa;
+    long exponent;
+    if (parse_decimal(str, size, &negative, &mantissa, &exponent) && mantissa <= (1ULL << 24) && exponent >= -10 && exponent <= 10)
+    {
+        float val = (float)mantissa;
+        val = exponent < 0 ? val / float_powers[-exponent] : val * float_powers[exponent];
+        *value = negative ? -val : val;
+        return INPUT_OK;
+    }
+#endif
+
+    str = terminate(r, str, size);
+    if (str == NULL)
+        return INPUT_ALLOC;
+
+    while (isspace((unsigned char)*str)) // Trim leading whitespace
+        str++;
+
+    if (*str == '\0') // Check for empty string
+        return INPUT_SYNTAX;
+
+    errno = 0;
+    char *end;
+    float val = strtof(str, &end); // Convert string to float
+
+    while (isspace((unsigned char)*end)) // Trim trailing whitespace
+        end++;
+
+    // Check remaining string, counting inf and nan as invalid characters, then range
+    if (*end != '\0' || (errno == 0 && !isfinite(val)))
+        return INPUT_SYNTAX;
+    if (errno != 0 || val < -FLT_MAX || val > FLT_MAX)
+        return INPUT_RANGE;
+    *value = val;
+    return INPUT_OK;
+}
+
+// Parse double in [-DBL_MAX, DBL_MAX] like strtod(3), rejecting inf, nan, and subnormal numbers
+// Use exact fast path or Eisel-Lemire path if possible, otherwise copy characters into scratch buffer of reader for strtod(3)
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters, INPUT_RANGE on out of range value, or INPUT_ALLOC on errors
+static input_status parse_double(reader *r, const char *str, size_t size, double *value)
+{
+#ifdef FAST_FLOAT
+    bool negative;
+    uint64_t mantissa;
+    long exponent;
+    if (parse_decimal(str, size, &negative, &mantissa, &exponent))
+    {
+        // Move powers of 10 beyond 1e22 into significand while it stays exact
+        for (; exponent > 22 && exponent <= 22 + 16 && mantissa <= (1ULL << 53) / 10; exponent--)
+            mantissa *= 10;
+
+        double val;
+        if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+        {
+            val = (double)mantissa;
+            val = exponent < 0 ? val / double_powers[-exponent] : val * double_powers[exponent];
+            *value = negative ? -val : val;
+            return INPUT_OK;
+        }
+#ifdef EISEL_LEMIRE
+        if (parse_binary64(mantissa, exponent, &val)) // Round longer significand or larger power without strtod(3)
+        {
+            *value = negative ? -val : val;
+            return INPUT_OK;
+        }
+#endif
+    }
+#endif
+
+    str = terminate(r, str, size);
+    if (str == NULL)
+        return INPUT_ALLOC;
+
+    while (isspace((unsigned char)*str)) // Trim leading whitespace
+        str++;
+
+    if (*str == '\0') // Check for empty string
+        return INPUT_SYNTAX;
+
+    errno = 0;
+    char *end;
+    double val = strtod(str, &end); // Convert string to double
+
+    while (isspace((unsigned char)*end)) // Trim trailing whitespace
+        end++;
+
+    // Check remaining string, counting inf and nan as invalid characters, then range
+    if (*end != '\0' || (errno == 0 && !isfinite(val)))
+        return INPUT_SYNTAX;
+    if (errno != 0 || val < -DBL_MAX || val > DBL_MAX)
+        return INPUT_RANGE;
+    *value = val;
+    return INPUT_OK;
+}
+
+// Parse long double in [-LDBL_MAX, LDBL_MAX] like strtold(3), rejecting inf, nan, and subnormal numbers
+// Use exact fast path if possible, otherwise copy characters into scratch buffer of reader for strtold(3)
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters, INPUT_RANGE on out of range value, or INPUT_ALLOC on errors
+static input_status parse_long_double(reader *r, const char *str, size_t size, long double *value)
+{
+    bool negative;
+    uint64_t mantissa;
+    long exponent;
+    if (parse_decimal(str, size, &negative, &mantissa, &exponent) && mantissa <= LDBL_FAST_MANTISSA &&
+        exponent >= -LDBL_FAST_EXPONENT && exponent <= LDBL_FAST_EXPONENT)
+    {
+        long double val = (long double)mantissa;
+        val = exponent < 0 ? val / long_double_powers[-exponent] : val * long_double_powers[exponent];
+        *value = negative ? -val : val;
+        return INPUT_OK;
+    }
+
+    str = terminate(r, str, size);
+    if (str == NULL)
+        return INPUT_ALLOC;
+
+    while (isspace((unsigned char)*str)) // Trim leading whitespace
+        str++;
+
+    if (*str == '\0') // Check for empty string
+        return INPUT_SYNTAX;
+
+    errno = 0;
+    char *end;
+    long double val = strtold(str, &end); // Convert string to long double
+
+    while (isspace((unsigned char)*end)) // Trim trailing whitespace
+        end++;
+
+    // Check remaining string, counting inf and nan as invalid characters, then range
+    if (*end != '\0' || (errno == 0 && !isfinite(val)))
+        return INPUT_SYNTAX;
+    if (errno != 0 || val < -LDBL_MAX || val > LDBL_MAX)
+        return INPUT_RANGE;
+    *value = val;
+    return INPUT_OK;
+}
+
+// Define pointer type for parsers of array elements, storing value of element type only if string is valid
+// Return INPUT_OK, or INPUT_SYNTAX on invalid characters, INPUT_RANGE on out of range value, or INPUT_ALLOC on errors
+typedef input_status (*element)(reader *r, const char *str, size_t size, void *value);
+
+// Parse char element, accepting single character, or single character surrounded by whitespace
+static input_status char_element(reader *r, const char *str, size_t size, void *value)
+{
+    if (size != 1)
+    {
+        while (size > 0 && blank(*str)) // Trim leading whitespace
+            str++, size--;
+        while (size > 0 && blank(str[size - 1])) // Trim trailing whitespace
+            size--;
+    }
+
+    if (size != 1)
+        return INPUT_SYNTAX;
+    *(char *)value = *str;
+    return INPUT_OK;
+}
+
+// Parse unsigned char element like char element
+static input_status unsigned_char_element(reader *r, const char *str, size_t size, void *value)
+{
+    char val;
+    input_status status = char_element(r, str, size, &val);
+    if (status == INPUT_OK)
+        *(unsigned char *)value = (unsigned char)val; // Cast char to unsigned char
+    return status;
+}
+
+// Parse int element of array
+static input_status int_element(reader *r, const char *str, size_t size, void *value)
+{
+    long long val;
+    input_status status = parse_signed(str, size, INT_MIN, INT_MAX, &val);
+    if (status == INPUT_OK)
+        *(int *)value = (int)val;
+    return status;
+}
+
+// Parse unsigned int element of array
+static input_status unsigned_int_element(reader *r, const char *str, size_t size, void *value)
+{
+    unsigned long long val;
+    input_status status = parse_unsigned(str, size, UINT_MAX, &val);
+    if (status == INPUT_OK)
+        *(unsigned int *)value = (unsigned int)val;
+    return status;
+}
+
+// Parse long element of array
+static input_status long_element(reader *r, const char *str, size_t size, void *value)
+{
+    long long val;
+    input_status status = parse_signed(str, size, LONG_MIN, LONG_MAX, &val);
+    if (status == INPUT_OK)
+        *(long *)value = (long)val;
+    return status;
+}
+
+// Parse unsigned long element of array
+static input_status unsigned_long_element(reader *r, const char *str, size_t size, void *value)
+{
+    unsigned long long val;
+    input_status status = parse_unsigned(str, size, ULONG_MAX, &val);
+    if (status == INPUT_OK)
+        *(unsigned long *)value = (unsigned long)val;
+    return status;
+}
+
+// Parse long long element of array
+static input_status long_long_element(reader *r, const char *str, size_t size, void *value)
+{
+    return parse_signed(str, size, LLONG_MIN, LLONG_MAX, value);
+}
+
+// Parse unsigned long long element of array
+static input_status unsigned_long_long_element(reader *r, const char *str, size_t size, void *value)
+{
+    return parse_unsigned(str, size, ULLONG_MAX, value);
+}
+
+// Parse float element of array
+static input_status float_element(reader *r, const char *str, size_t size, void *value)
+{
+    return parse_float(r, str, size, value);
+}
+
+// Parse double element of array
+static input_status double_element(reader *r, const char *str, size_t size, void *value)
+{
+    return parse_double(r, str, size, value);
+}
+
+// Parse long double element of array
+static input_status long_double_element(reader *r, const char *str, size_t size, void *value)
+{
+    return parse_long_double(r, str, size, value);
+}
+
+// Check for separator of array elements
+static inline bool separator(char c)
+{
+    return c == ',' || blank(c);
+}
+
+// Prompt user once and read count elements of width bytes from reader, separated by whitespace or commas, across lines
+// Parse each element with parse function, storing sentinel value and false in valid if element is rejected
+// Discard rest of line after last element, and store sentinel value and false in valid for elements missing at EOF
+// Allocate array in arena in use if array is NULL
+// Return array and update count to number of elements read, or return NULL on errors or no input (EOF)
+static void *read_array(reader *r, void *array, size_t width, size_t *count, bool *valid, const void *sentinel,
+                        element parse, const char *format, va_list *args)
+{
+    if (count == NULL)
+        return NULL;
+
+    // Allocate array in arena in use if caller provides none
+    size_t wanted = *count;
+    arena *scope = self != NULL ? self->scope : NULL;
+    if (array == NULL && (scope == NULL || wanted > SIZE_MAX / width || (array = carve(scope, wanted * width)) == NULL))
+        return NULL;
+
+    prompt(format, args, false);
+
+    unsigned char *elements = array;
+    line_view line = {NULL, 0};
+    size_t i = 0, n = 0; // Indicate position in line and number of elements read
+    while (n < wanted)
+    {
+        while (i < line.size && separator(line.data[i])) // Skip separators
+            i++;
+
+        if (i == line.size) // Read next line without prompting again
+        {
+            if (!read_view(r, NULL, NULL, false, &line))
+                break;
+            i = 0;
+            continue;
+        }
+
+        size_t start = i;
+        while (i < line.size && !separator(line.data[i])) // Find end of element
+            i++;
+
+        bool ok = PARSE(parse(r, line.data + start, i - start, elements + n * width)) == INPUT_OK;
+        if (!ok)
+            memcpy(elements + n * width, sentinel, width);
+        if (valid != NULL)
+            valid[n] = ok;
+        n++;
+    }
+
+    // Mark elements missing at EOF
+    for (size_t k = n; k < wanted; k++)
+    {
+        memcpy(elements + k * width, sentinel, width);
+        if (valid != NULL)
+            valid[k] = false;
+    }
+
+    *count = n;
+    return n == 0 && wanted > 0 ? NULL : array;
+}
+
+// Prompt user and read line from reader without copying it for get_line_view functions
+// Return view with NULL data on errors or no input (EOF)
+static line_view read_line_view(reader *r, const char *format, va_list *args)
+{
+    prompt(format, args, false);
+
+    line_view view;
+    if (!view_line(r, &view))
+        return (line_view){NULL, 0};
+    return view;
+}
+
+// Prompt user for line of characters from standard input without copying it
+// Return view of line, valid until next read. If user inputs only line ending, returns empty view with non-NULL data
+// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings
+// Return view with NULL data on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+line_view get_line_view(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    line_view view = read_line_view(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return view;
+}
+
+// Prompt user for input from stream like get_line_view function, or from standard input if stream is NULL
+line_view get_line_view_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    line_view view = read_line_view(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return view;
+}
+
+// Prompt user and pass line from reader to callback in pieces of size bytes, last piece shorter, for get_line_chunks function
+// Pass bytes in block to callback without copying while more bytes of line follow, otherwise gather piece in scratch buffer
+// Return status of call
+static input_status read_chunks(reader *r, size_t size, chunk_callback callback, void *context, const char *format, va_list *args)
+{
+    if (size == 0 || callback == NULL)
+        return r->status = INPUT_RANGE;
+
+    char *piece = reserve(r->scratch, &r->room, size);
+    if (piece == NULL)
+        return r->status = INPUT_ALLOC;
+    r->scratch = piece;
+
+    prompt(format, args, false);
+
+    size_t held = 0, total = 0; // Indicate number of bytes in piece and in line
+    int c = 0;                  // Read line ending, EOF, or 0 for more characters
+    while (c == 0)
+    {
+        const unsigned char *bytes;
+        size_t n = segment(r, &bytes, &c);
+        total += n;
+
+        while (n > 0)
+        {
+            if (held == size) // Pass full piece, since more bytes follow
+            {
+                callback(context, piece, size, false);
+                held = 0;
+            }
+
+            if (held == 0 && n > size) // Pass piece in block
+            {
+                callback(context, (const char *)bytes, size, false);
+                bytes += size;
+                n -= size;
+                continue;
+            }
+
+            size_t k = n < size - held ? n : size - held;
+            memcpy(piece + held, bytes, k); // Gather piece in scratch buffer
+            held += k;
+            bytes += k;
+            n -= k;
+        }
+    }
+
+    // Check for no input from user, keeping piece for next call on timeout
+    if ((total == 0 && c == EOF) || r->timed_out)
+    {
+        suspend(r, (const unsigned char *)piece, held);
+        return r->status;
+    }
+
+    STAT(lines, 1);
+    callback(context, piece, held, true);
+    return r->status;
+}
+
+// Prompt user for line of characters from stream, or from standard input if stream is NULL, without buffering whole line
+// Pass line to callback in pieces of size bytes, last piece shorter and marked as last, for lines of any length
+// Return INPUT_OK, or INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, or INPUT_RANGE if size is 0
+// Format prompt like printf(3) function for user
+input_status get_line_chunks(stream *s, size_t size, chunk_callback callback, void *context, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = read_chunks(r, size, callback, context, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Count bytes needed by string read from reader in its size class, halving counts once window is full
+// Size first buffer of next string to hold LENGTH_PERCENTILE of recent strings without growing
+static void learn(reader *r, size_t needed)
+{
+    size_t k = 0;
+    while (k + 1 < LENGTH_CLASSES && (size_t)BUFFER_CAPACITY << k < needed)
+        k++;
+    r->lengths[k]++;
+
+    if (++r->measured == 2 * LENGTH_WINDOW) // Forget older strings, so sizing follows changes in input
+    {
+        r->measured = 0;
+        for (size_t i = 0; i < LENGTH_CLASSES; i++)
+            r->measured += r->lengths[i] /= 2;
+    }
+
+    size_t covered = 0;
+    for (k = 0; k + 1 < LENGTH_CLASSES; k++)
+        if ((covered += r->lengths[k]) * 100 >= r->measured * LENGTH_PERCENTILE)
+            break;
+    r->expected = (size_t)BUFFER_CAPACITY << k;
+}
+
+// Grow buffer of string to hold needed characters, moving size characters from stack to heap on first growth
+// Start buffer on heap at capacity of recent strings of reader, and double it until characters fit
+// Return characters after header of buffer, or NULL on errors, freeing buffer
+static unsigned char *enlarge(reader *r, unsigned char **buffer, size_t *capacity, const unsigned char *chars, size_t size, size_t needed)
+{
+    size_t wanted = *buffer != NULL ? *capacity : r->expected > 2 * BUFFER_CAPACITY ? r->expected : 2 * BUFFER_CAPACITY;
+    while (wanted < needed) // Increment buffer capacity exponentially
+    {
+        if (wanted >= SIZE_MAX / 2) // Consider terminating zero
+        {
+            free(*buffer);
+            return NULL;
+        }
+        wanted *= 2;
+    }
+
+    unsigned char *temp;
+    if (*buffer == NULL) // Move line from stack
+    {
+        if ((temp = malloc(HEADER + wanted)) != NULL)
+            memcpy(temp + HEADER, chars, size);
+    }
+    else if ((temp = realloc(*buffer, HEADER + wanted)) != NULL)
+        STAT(grows, 1);
+
+    if (temp == NULL)
+    {
+        free(*buffer);
+        return NULL;
+    }
+    *buffer = temp;
+    *capacity = wanted;
+    return temp + HEADER;
+}
+
+// Prompt user and read line from reader into string for get_string functions
+// Return string on heap or in arena in use, or NULL on errors or no input (EOF)
+static char *read_string(reader *r, const char *format, va_list *args)
+{
+    // Check for space in registry of calling thread
+    local *l = own();
+    if (l == NULL || l->strings.allocations == POOLED - 1) // Keep flag of header clear
+        return exhausted(r);
+
+    // Prompt user using formatted string with variadic arguments
+    prompt(format, args, false);
+
+    // Read line into arena instead of heap if arena is in use
+    if (l->scope != NULL)
+        return read_arena(r, l->scope);
+
+    // Initialise buffer for characters on stack while line fits cell of pool, considering terminating zero
+    unsigned char small[POOL_STRING - 1];
+    unsigned char *chars = small;      // Indicate characters of line, on stack or after header of buffer on heap
+    unsigned char *buffer = NULL;      // Indicate buffer on heap, or NULL while line is on stack
+    size_t capacity = POOL_STRING - 1; // Indicate number of characters buffer holds
+
+    // Start on heap instead, sized for most recent strings, if they are too long for cell of pool
+    if (r->expected > 2 * BUFFER_CAPACITY)
+    {
+        if ((buffer = malloc(HEADER + r->expected)) == NULL)
+            return exhausted(r);
+        chars = buffer + HEADER;
+        capacity = r->expected;
+    }
+
+    size_t size;        // Indicate number of characters in buffer
+    line_policy policy; // Indicate policy for line read
+
+    // Read next line into buffer if long line is discarded
+    do
+    {
+        size = 0;
+        int c = 0; // Read line ending, EOF, or 0 for more characters
+
+        // Get segments of characters from standard input
+        while (c == 0)
+        {
+            const unsigned char *bytes;
+            size_t n = bounded(r, &bytes, &c);
+
+            if (size + n > capacity && (chars = enlarge(r, &buffer, &capacity, chars, size, size + n)) == NULL)
+                return exhausted(r);
+
+            memcpy(chars + size, bytes, n); // Append characters to buffer
+            size += n;
+        }
+
+        // Check for no input from user, keeping line for next call on timeout
+        if ((size == 0 && c == EOF) || r->timed_out)
+        {
+            suspend(r, chars, size);
+            free(buffer);
+            return NULL;
+        }
+    } while ((policy = verdict(r)) == LINE_DISCARD);
+
+    if (policy == LINE_REJECT) // Fail call for long line
+    {
+        free(buffer);
+        r->status = INPUT_LONG;
+        return NULL;
+    }
+
+    learn(r, size + 1);
+    char *str;
+    if (size < POOL_STRING) // Move short line into cell of pool
+    {
+        str = take_cell(&l->strings);
+        if (str != NULL)
+            memcpy(str, chars, size);
+        free(buffer);
+        if (str == NULL)
+            return exhausted(r);
+        buffer = NULL;
+    }
+    else
+    {
+        // Check space for terminating zero
+        if (size >= SIZE_MAX - HEADER)
+        {
+            free(buffer);
+            return exhausted(r);
+        }
+
+        // Minimise buffer, keeping it if slack is too small for allocator to reuse
+        unsigned char *temp = buffer;
+        if (capacity == size || capacity - size - 1 >= SHRINK_SLACK)
+            temp = realloc(buffer, HEADER + size + 1);
+        if (temp == NULL)
+        {
+            free(buffer);
+            return exhausted(r);
+        }
+        str = (char *)temp + HEADER;
+    }
+    str[size] = '\0'; // Terminate string
+
+    // Append string to registry
+    if (!store(&l->strings, str, buffer == NULL))
+    {
+        if (buffer == NULL)
+            give_cell(&l->strings, str);
+        else
+            free(str - HEADER);
+        return exhausted(r);
+    }
+
+    STAT(lines, 1);
+    return str; // Return string
+}
+
+// Prompt user for line of characters from standard input
+// Return string (char *) value. If user inputs only line ending, returns "" not NULL
+// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings
+// Return NULL on errors or no input (EOF)
+// Store string on heap, library destructor frees memory on program exit
+// Format prompt like printf(3) function for user
+#undef get_string
+char *get_string(va_list *args, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    char *str = read_string(r, format, args != NULL ? args : &ap); // Use wrapper function arguments if given
+    relinquish(r);
+    va_end(ap);
+    return str;
+}
+
+// Prompt user for input from stream like get_string function, or from standard input if stream is NULL
+char *get_string_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    char *str = read_string(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return str;
+}
+
+// Prompt user once for line of characters from stream, or from standard input if stream is NULL, like get_string function
+// Store string in value (not NULL), and return INPUT_OK, or INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, or INPUT_LONG leaving value unchanged
+input_status try_get_string(stream *s, char **value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    char *str = read_string(r, format, &ap);
+    if (str != NULL)
+        *value = str;
+    input_status status = r->status;
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Prompt user and read char from reader for get_char functions
+static char read_char(reader *r, const char *format, va_list *args)
+{
+    // Try to get char from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return CHAR_MAX; // Return sentinel value on error
+
+        char val;
+        if (PARSE(char_element(r, line.data, line.size, &val)) == INPUT_OK) // Accept single char, trimming whitespace around it
+            return val;
+        STAT(retries[STATS_CHAR], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return char value. If string does not represent single char, prompt user to retry
+// Return CHAR_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+char get_char(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    char val = read_char(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_char function, or from standard input if stream is NULL
+char get_char_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    char val = read_char(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read unsigned char from reader for get_unsigned_char functions
+static unsigned char read_unsigned_char(reader *r, const char *format, va_list *args)
+{
+    // Try to get char from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return UCHAR_MAX; // Return sentinel value on error
+
+        unsigned char val;
+        if (PARSE(unsigned_char_element(r, line.data, line.size, &val)) == INPUT_OK) // Accept single char, trimming whitespace around it
+            return val;
+        STAT(retries[STATS_UNSIGNED_CHAR], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return unsigned char value. If string does not represent single char, prompt user to retry
+// Return UCHAR_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+unsigned char get_unsigned_char(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned char val = read_unsigned_char(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_unsigned_char function, or from standard input if stream is NULL
+unsigned char get_unsigned_char_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned char val = read_unsigned_char(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read int from reader for get_int functions
+static int read_int(reader *r, const char *format, va_list *args)
+{
+    // Try to get int from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return INT_MAX; // Return sentinel value on error
+
+        long long val;
+        if (PARSE(parse_signed(line.data, line.size, INT_MIN, INT_MAX, &val)) == INPUT_OK) // Convert line to int in range
+            return (int)val;
+        STAT(retries[STATS_INT], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return int value. If string does not represent int in [INT_MIN, INT_MAX], prompt user to retry
+// Return INT_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+int get_int(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    int val = read_int(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_int function, or from standard input if stream is NULL
+int get_int_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    int val = read_int(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read unsigned int from reader for get_unsigned_int functions
+static unsigned int read_unsigned_int(reader *r, const char *format, va_list *args)
+{
+    // Try to get unsigned int from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return UINT_MAX; // Return sentinel value on error
+
+        unsigned long long val;
+        if (PARSE(parse_unsigned(line.data, line.size, UINT_MAX, &val)) == INPUT_OK) // Convert line to unsigned int in range
+            return (unsigned int)val;
+        STAT(retries[STATS_UNSIGNED_INT], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return unsigned int value. If string does not represent unsigned int in [0, UINT_MAX], prompt user to retry
+// Return UINT_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+unsigned int get_unsigned_int(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned int val = read_unsigned_int(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_unsigned_int function, or from standard input if stream is NULL
+unsigned int get_unsigned_int_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned int val = read_unsigned_int(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read long from reader for get_long functions
+static long read_long(reader *r, const char *format, va_list *args)
+{
+    // Try to get long from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return LONG_MAX; // Return sentinel value on error
+
+        long long val;
+        if (PARSE(parse_signed(line.data, line.size, LONG_MIN, LONG_MAX, &val)) == INPUT_OK) // Convert line to long in range
+            return (long)val;
+        STAT(retries[STATS_LONG], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return long value. If string does not represent long in [LONG_MIN, LONG_MAX], prompt user to retry
+// Return LONG_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+long get_long(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long val = read_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_long function, or from standard input if stream is NULL
+long get_long_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long val = read_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read unsigned long from reader for get_unsigned_long functions
+static unsigned long read_unsigned_long(reader *r, const char *format, va_list *args)
+{
+    // Try to get unsigned long from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return ULONG_MAX; // Return sentinel value on error
+
+        unsigned long long val;
+        if (PARSE(parse_unsigned(line.data, line.size, ULONG_MAX, &val)) == INPUT_OK) // Convert line to unsigned long in range
+            return (unsigned long)val;
+        STAT(retries[STATS_UNSIGNED_LONG], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return unsigned long value. If string does not represent unsigned long in [0, ULONG_MAX], prompt user to retry
+// Return ULONG_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+unsigned long get_unsigned_long(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned long val = read_unsigned_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_unsigned_long function, or from standard input if stream is NULL
+unsigned long get_unsigned_long_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned long val = read_unsigned_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read long long from reader for get_long_long functions
+static long long read_long_long(reader *r, const char *format, va_list *args)
+{
+    // Try to get long long from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return LLONG_MAX; // Return sentinel value on error
+
+        long long val;
+        if (PARSE(parse_signed(line.data, line.size, LLONG_MIN, LLONG_MAX, &val)) == INPUT_OK) // Convert line to long long in range
+            return (long long)val;
+        STAT(retries[STATS_LONG_LONG], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return long long value. If string does not represent long long in [LLONG_MIN, LLONG_MAX], prompt user to retry
+// Return LLONG_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+long long get_long_long(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long long val = read_long_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_long_long function, or from standard input if stream is NULL
+long long get_long_long_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long long val = read_long_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read unsigned long long from reader for get_unsigned_long_long functions
+static unsigned long long read_unsigned_long_long(reader *r, const char *format, va_list *args)
+{
+    // Try to get unsigned long long from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return ULLONG_MAX; // Return sentinel value on error
+
+        unsigned long long val;
+        if (PARSE(parse_unsigned(line.data, line.size, ULLONG_MAX, &val)) == INPUT_OK) // Convert line to unsigned long long in range
+            return (unsigned long long)val;
+        STAT(retries[STATS_UNSIGNED_LONG_LONG], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return unsigned long long value. If string does not represent unsigned long long in [0, ULLONG_MAX], prompt user to retry
+// Return ULLONG_MAX as sentinel value if string cannot be read
+// Format prompt like printf(3) function for user
+unsigned long long get_unsigned_long_long(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned long long val = read_unsigned_long_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_unsigned_long_long function, or from standard input if stream is NULL
+unsigned long long get_unsigned_long_long_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned long long val = read_unsigned_long_long(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read float from reader for get_float functions
+static float read_float(reader *r, const char *format, va_list *args)
+{
+    // Try to get float from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return FLT_MAX; // Return sentinel value on error
+
+        float val;
+        if (PARSE(parse_float(r, line.data, line.size, &val)) == INPUT_OK) // Convert line to float in range
+            return val;
+        STAT(retries[STATS_FLOAT], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return float value. If string does not represent float in [-FLT_MAX, FLT_MAX], prompt user to retry
+// Return FLT_MAX as sentinel value if string cannot be read
+// Ignore finite subnormal numbers
+// Format prompt like printf(3) function for user
+float get_float(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    float val = read_float(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_float function, or from standard input if stream is NULL
+float get_float_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    float val = read_float(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read double from reader for get_double functions
+static double read_double(reader *r, const char *format, va_list *args)
+{
+    // Try to get double from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return DBL_MAX; // Return sentinel value on error
+
+        double val;
+        if (PARSE(parse_double(r, line.data, line.size, &val)) == INPUT_OK) // Convert line to double in range
+            return val;
+        STAT(retries[STATS_DOUBLE], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return double value. If string does not represent double in [-DBL_MAX, DBL_MAX], prompt user to retry
+// Return DBL_MAX as sentinel value if string cannot be read
+// Ignore finite subnormal numbers
+// Format prompt like printf(3) function for user
+double get_double(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    double val = read_double(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_double function, or from standard input if stream is NULL
+double get_double_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    double val = read_double(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user and read long double from reader for get_long_double functions
+static long double read_long_double(reader *r, const char *format, va_list *args)
+{
+    // Try to get long double from user
+    for (bool retry = false;; retry = true)
+    {
+        line_view line;
+        if (!read_view(r, format, args, retry, &line)) // Get line of characters without allocating
+            return LDBL_MAX; // Return sentinel value on error
+
+        long double val;
+        if (PARSE(parse_long_double(r, line.data, line.size, &val)) == INPUT_OK) // Convert line to long double in range
+            return val;
+        STAT(retries[STATS_LONG_DOUBLE], 1); // Count rejected line before retrying
+    }
+}
+
+// Prompt user for line of characters from standard input without allocating
+// Return long double value. If string does not represent long double in [-LDBL_MAX, LDBL_MAX], prompt user to retry
+// Return LDBL_MAX as sentinel value if string cannot be read
+// Ignore finite subnormal numbers
+// Format prompt like printf(3) function for user
+long double get_long_double(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long double val = read_long_double(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user for input from stream like get_long_double function, or from standard input if stream is NULL
+long double get_long_double_from(stream *s, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long double val = read_long_double(r, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return val;
+}
+
+// Prompt user once and parse line from reader with parse function for try_get functions, without retrying
+// Store value only if line is valid, and return status of call
+static input_status try_read(reader *r, element parse, void *value, const char *format, va_list *args)
+{
+    line_view line;
+    if (read_view(r, format, args, false, &line))
+        r->status = PARSE(parse(r, line.data, line.size, value));
+    return r->status;
+}
+
+// Prompt user once for line of characters from stream, or from standard input if stream is NULL, without allocating
+// Parse line once like get_int function, without retrying, and store int value in value (not NULL)
+// Return INPUT_OK, or status telling why value is unchanged: INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, INPUT_RANGE, INPUT_SYNTAX,
+// or INPUT_LONG for line longer than limit of stream rejected
+// Format prompt like printf(3) function for user
+input_status try_get_int(stream *s, int *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, int_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing char value like get_char function
+input_status try_get_char(stream *s, char *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, char_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing unsigned char value like get_unsigned_char function
+input_status try_get_unsigned_char(stream *s, unsigned char *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, unsigned_char_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing unsigned int value like get_unsigned_int function
+input_status try_get_unsigned_int(stream *s, unsigned int *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, unsigned_int_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing long value like get_long function
+input_status try_get_long(stream *s, long *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, long_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing unsigned long value like get_unsigned_long function
+input_status try_get_unsigned_long(stream *s, unsigned long *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, unsigned_long_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing long long value like get_long_long function
+input_status try_get_long_long(stream *s, long long *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, long_long_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing unsigned long long value like get_unsigned_long_long function
+input_status try_get_unsigned_long_long(stream *s, unsigned long long *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, unsigned_long_long_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing float value like get_float function
+input_status try_get_float(stream *s, float *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, float_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing double value like get_double function
+input_status try_get_double(stream *s, double *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, double_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Read input once like try_get_int function, storing long double value like get_long_double function
+input_status try_get_long_double(stream *s, long double *value, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    input_status status = try_read(r, long_double_element, value, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return status;
+}
+
+// Prompt user once for count int values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and INT_MAX for each string that does not represent int in [INT_MIN, INT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+int *get_int_array(int *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const int sentinel = INT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    int *values = read_array(r, array, sizeof(int), count, valid, &sentinel, int_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_int_array function, or from standard input if stream is NULL
+int *get_int_array_from(stream *s, int *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const int sentinel = INT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    int *values = read_array(r, array, sizeof(int), count, valid, &sentinel, int_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count unsigned int values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and UINT_MAX for each string that does not represent unsigned int in [0, UINT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned int *get_unsigned_int_array(unsigned int *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned int sentinel = UINT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned int *values = read_array(r, array, sizeof(unsigned int), count, valid, &sentinel, unsigned_int_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_unsigned_int_array function, or from standard input if stream is NULL
+unsigned int *get_unsigned_int_array_from(stream *s, unsigned int *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned int sentinel = UINT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned int *values = read_array(r, array, sizeof(unsigned int), count, valid, &sentinel, unsigned_int_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LONG_MAX for each string that does not represent long in [LONG_MIN, LONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long *get_long_array(long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long sentinel = LONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long *values = read_array(r, array, sizeof(long), count, valid, &sentinel, long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_long_array function, or from standard input if stream is NULL
+long *get_long_array_from(stream *s, long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long sentinel = LONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long *values = read_array(r, array, sizeof(long), count, valid, &sentinel, long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count unsigned long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and ULONG_MAX for each string that does not represent unsigned long in [0, ULONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned long *get_unsigned_long_array(unsigned long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned long sentinel = ULONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned long *values = read_array(r, array, sizeof(unsigned long), count, valid, &sentinel, unsigned_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_unsigned_long_array function, or from standard input if stream is NULL
+unsigned long *get_unsigned_long_array_from(stream *s, unsigned long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned long sentinel = ULONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned long *values = read_array(r, array, sizeof(unsigned long), count, valid, &sentinel, unsigned_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count long long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LLONG_MAX for each string that does not represent long long in [LLONG_MIN, LLONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long long *get_long_long_array(long long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long long sentinel = LLONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long long *values = read_array(r, array, sizeof(long long), count, valid, &sentinel, long_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_long_long_array function, or from standard input if stream is NULL
+long long *get_long_long_array_from(stream *s, long long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long long sentinel = LLONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long long *values = read_array(r, array, sizeof(long long), count, valid, &sentinel, long_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count unsigned long long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and ULLONG_MAX for each string that does not represent unsigned long long in [0, ULLONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned long long *get_unsigned_long_long_array(unsigned long long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned long long sentinel = ULLONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    unsigned long long *values = read_array(r, array, sizeof(unsigned long long), count, valid, &sentinel, unsigned_long_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_unsigned_long_long_array function, or from standard input if stream is NULL
+unsigned long long *get_unsigned_long_long_array_from(stream *s, unsigned long long *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const unsigned long long sentinel = ULLONG_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    unsigned long long *values = read_array(r, array, sizeof(unsigned long long), count, valid, &sentinel, unsigned_long_long_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count float values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and FLT_MAX for each string that does not represent float in [-FLT_MAX, FLT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+float *get_float_array(float *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const float sentinel = FLT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    float *values = read_array(r, array, sizeof(float), count, valid, &sentinel, float_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_float_array function, or from standard input if stream is NULL
+float *get_float_array_from(stream *s, float *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const float sentinel = FLT_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    float *values = read_array(r, array, sizeof(float), count, valid, &sentinel, float_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count double values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and DBL_MAX for each string that does not represent double in [-DBL_MAX, DBL_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+double *get_double_array(double *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const double sentinel = DBL_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    double *values = read_array(r, array, sizeof(double), count, valid, &sentinel, double_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_double_array function, or from standard input if stream is NULL
+double *get_double_array_from(stream *s, double *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const double sentinel = DBL_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    double *values = read_array(r, array, sizeof(double), count, valid, &sentinel, double_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user once for count long double values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LDBL_MAX for each string that does not represent long double in [-LDBL_MAX, LDBL_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long double *get_long_double_array(long double *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long double sentinel = LDBL_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(NULL);
+    long double *values = read_array(r, array, sizeof(long double), count, valid, &sentinel, long_double_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Prompt user for input from stream like get_long_double_array function, or from standard input if stream is NULL
+long double *get_long_double_array_from(stream *s, long double *array, size_t *count, bool *valid, const char *format, ...)
+{
+    static const long double sentinel = LDBL_MAX;
+
+    va_list ap;
+    va_start(ap, format);
+    reader *r = acquire(s);
+    long double *values = read_array(r, array, sizeof(long double), count, valid, &sentinel, long_double_element, format, &ap);
+    relinquish(r);
+    va_end(ap);
+    return values;
+}
+
+// Define number of bytes of streamed input parsed in each batch, and minimum number of bytes in each chunk
+// Allow tests to shrink batches, so lines straddle many batches
+#ifndef LOAD_CAPACITY
+#define LOAD_CAPACITY (1 << 22)
+#endif
+#define CHUNK_CAPACITY 65536
+
+// Define number of chunks for each thread in batch, so threads finishing early take chunks left by slower threads
+#define CHUNKS_PER_THREAD 8
+
+// Define chunk of whole lines counted and then parsed by one thread for load_doubles function
+typedef struct chunk
+{
+    const unsigned char *bytes; // First byte of chunk, at start of line
+    size_t size;                // Number of bytes in chunk
+    size_t count;               // Number of lines in chunk
+    size_t first;               // Index of first line of chunk in values of load
+    size_t *errors;             // Line numbers of rejected lines in chunk, from 1
+    size_t rejected;            // Number of rejected lines in chunk
+    size_t room;                // Number of bytes in errors buffer
+    bool failed;                // Indicate allocation failed
+} chunk;
+
+// Define stages run by threads on every chunk of batch
+typedef enum stage
+{
+    STAGE_COUNT, // Count lines of chunk
+    STAGE_PARSE, // Parse lines of chunk into values of load
+    STAGE_STOP   // End thread
+} stage;
+
+// Define values and rejected lines gathered by load_doubles function across batches, and threads kept for every batch
+typedef struct load
+{
+    double *values;     // Values of lines in order of input, written in place by threads
+    size_t count;       // Number of lines
+    size_t capacity;    // Number of bytes in values buffer
+    size_t *errors;     // Line numbers of rejected lines, from 1
+    size_t rejected;    // Number of rejected lines
+    size_t room;        // Number of bytes in errors buffer
+    chunk *chunks;      // Chunks reused by every batch
+    size_t chunked;     // Number of chunks in batch
+    stage step;         // Stage run on chunks of batch
+    size_t round;       // Number of stages started, so threads wait for next stage
+    size_t next;        // Index of next chunk to take in stage
+    size_t done;        // Number of chunks finished in stage
+    mutex lock;         // Lock of stage, its next chunk, and its finished chunks
+    condition started;  // Signal of stage started
+    condition finished; // Signal of every chunk of stage finished
+    thread *ids;        // Threads kept for every batch
+    size_t spawned;     // Number of threads started
+    size_t threads;     // Number of threads, including calling thread
+    bool capped;        // Indicate lines are limited to limit characters, like lines of reader
+    size_t limit;       // Maximum number of characters of each line, if capped
+    line_policy policy; // Policy for lines longer than limit
+} load;
+
+// Return number of processors online, or 1 if unknown
+static size_t processors(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#endif
+}
+
+// Return index past first line ending at or after index, or size if no line ending follows
+// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings
+static size_t skip_line(const unsigned char *bytes, size_t size, size_t i)
+{
+    const unsigned char *found = scan(bytes + i, size - i);
+    if (found == NULL)
+        return size;
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+    i = (size_t)(found - bytes) + 1;
+    if (*found == '\r' && i < size && bytes[i] == '\n') // Keep CRLF (\r\n) in one line
+        i++;
+    return i;
+}
 
-        if (*str == '\0') // Check for empty string
-            continue;
+// Return index past last line ending in bytes, or 0 if bytes contain none
+// Ignore CR (\r) as last byte, since LF (\n) of CRLF (\r\n) may follow in next read
+static size_t last_line(const unsigned char *bytes, size_t size)
+{
+    for (size_t i = size; i > 0; i--)
+        if (bytes[i - 1] == '\n' || (bytes[i - 1] == '\r' && i < size))
+            return i;
+    return 0;
+}
 
-        char *end = str + strlen(str) - 1;
-        while (end > str && isspace((unsigned char)*end)) // Trim trailing whitespace
-            *end-- = '\0';
+// Return number of characters of line from index up to next line, excluding its line ending
+static size_t line_size(const unsigned char *bytes, size_t i, size_t next)
+{
+    size_t size = next - i;
+    while (size > 0 && (bytes[i + size - 1] == '\n' || bytes[i + size - 1] == '\r'))
+        size--;
+    return size;
+}
 
-        if (*str && *(str + 1) == '\0') // Return char if single char is provided
-        {
-            va_end(ap);
-            return (unsigned char)*str; // Cast char to unsigned char
-        }
+// Count lines of chunk, splitting lines like parse_chunk function, and leaving out lines discarded for their length
+static void count_chunk(load *l, chunk *c)
+{
+    c->count = 0;
+    bool discarding = l->capped && l->policy == LINE_DISCARD;
+    for (size_t i = 0; i < c->size;)
+    {
+        size_t next = skip_line(c->bytes, c->size, i);
+        if (!discarding || line_size(c->bytes, i, next) <= l->limit)
+            c->count++;
+        i = next;
     }
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return int value. If string does not represent int in [INT_MIN, INT_MAX], prompt user to retry
-// Return INT_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-int get_int(const char *format, ...)
+// Parse every line of chunk like get_double function into values of load from index of first line of chunk
+// Store DBL_MAX and line number of each rejected line, and apply policy of load to lines longer than limit
+static void parse_chunk(load *l, chunk *c)
 {
-    va_list ap;
-    va_start(ap, format);
+    reader r = {.kind = SOURCE_MEMORY}; // Hold scratch buffer of this thread for strtod(3) fallback
+    c->rejected = 0;
+    c->failed = false;
 
-    // Try to get int from user
-    while (true)
+    size_t k = c->first;
+    for (size_t i = 0, next; i < c->size; i = next)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
+        next = skip_line(c->bytes, c->size, i);
+        size_t size = line_size(c->bytes, i, next);
+
+        bool valid = true;
+        if (l->capped && size > l->limit) // Apply policy to long line
         {
-            va_end(ap);
-            return INT_MAX; // Return sentinel value on error
+            if (l->policy == LINE_DISCARD)
+                continue;
+            valid = l->policy == LINE_TRUNCATE;
+            size = l->limit;
         }
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
-
-        if (*str == '\0') // Check for empty string
-            continue;
-
-        errno = 0;
-        char *end;
-        long val = strtol(str, &end, 10); // Convert string to long
+        const char *line = (const char *)c->bytes + i;
+        const char *zero = memchr(line, '\0', size); // End line at first '\0' like get_double function
+        if (zero != NULL)
+            size = zero - line;
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+        double val;
+        valid = valid && parse_double(&r, line, size, &val) == INPUT_OK;
+        l->values[k] = valid ? val : DBL_MAX;
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val >= INT_MIN && val <= INT_MAX)
+        if (!valid)
         {
-            va_end(ap);
-            return (int)val; // Cast long to int
+            size_t *errors = reserve(c->errors, &c->room, (c->rejected + 1) * sizeof(size_t)); // Grow errors buffer if necessary
+            if (errors == NULL)
+            {
+                c->failed = true;
+                break;
+            }
+            c->errors = errors;
+            c->errors[c->rejected++] = k + 1;
         }
+        k++;
     }
+
+    free(r.scratch);
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return unsigned int value. If string does not represent unsigned int in [0, UINT_MAX], prompt user to retry
-// Return UINT_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-unsigned int get_unsigned_int(const char *format, ...)
+// Run stage on chunks of batch until none is left, with lock of load held
+static void take_chunks(load *l)
 {
-    va_list ap;
-    va_start(ap, format);
-
-    // Try to get unsigned int from user
-    while (true)
+    while (l->next < l->chunked)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return UINT_MAX; // Return sentinel value on error
-        }
+        chunk *c = &l->chunks[l->next++]; // Take next chunk
+        stage step = l->step;
+        unlock(&l->lock);
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+        if (step == STAGE_COUNT)
+            count_chunk(l, c);
+        else
+            parse_chunk(l, c);
 
-        if (*str == '\0') // Check for empty string
-            continue;
+        lock(&l->lock);
+        if (++l->done == l->chunked)
+            wake_all(&l->finished);
+    }
+}
 
-        if (*str == '-') // Reject negative value
-            continue;
+// Run every stage of load on chunks of its batches until load stops thread
+static WORKER(load_chunks)
+{
+    load *l = argument;
+    size_t round = 0;
+    lock(&l->lock);
+    while (true)
+    {
+        while (l->round == round) // Wait for next stage
+            sleep_on(&l->started, &l->lock);
+        round = l->round;
+        if (l->step == STAGE_STOP)
+            break;
+        take_chunks(l);
+    }
+    unlock(&l->lock);
+    return 0;
+}
 
-        errno = 0;
-        char *end;
-        unsigned long val = strtoul(str, &end, 10); // Convert string to unsigned long
+// Start stage on first chunks of load in its threads, starting threads for chunks first
+// Keep threads already started, and run stage on calling thread alone if threads cannot be created
+static void begin_stage(load *l, stage step, size_t chunked)
+{
+    while (l->spawned + 1 < l->threads && l->spawned + 1 < chunked && spawn(&l->ids[l->spawned], load_chunks, l))
+        l->spawned++;
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+    lock(&l->lock); // Change stage at once, so threads started late never see chunks of stage before
+    l->step = step;
+    l->chunked = chunked;
+    l->next = 0;
+    l->done = 0;
+    l->round++;
+    wake_all(&l->started);
+    unlock(&l->lock);
+}
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val <= UINT_MAX)
-        {
-            va_end(ap);
-            return (unsigned int)val; // Cast unsigned long to unsigned int
-        }
-    }
+// Run stage on chunks left by threads of load, then wait until every chunk of stage is finished
+static void end_stage(load *l)
+{
+    lock(&l->lock);
+    take_chunks(l);
+    while (l->done < l->chunked)
+        sleep_on(&l->finished, &l->lock);
+    unlock(&l->lock);
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return long value. If string does not represent long in [LONG_MIN, LONG_MAX], prompt user to retry
-// Return LONG_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-long get_long(const char *format, ...)
+// Split bytes of whole lines into chunks at line endings, count their lines on threads, and start parsing chunks on threads
+// Grow values of load for lines of batch, so threads write values in place from index of first line of each chunk
+// Return false on errors, leaving no stage running
+static bool begin_batch(load *l, const unsigned char *bytes, size_t size)
 {
-    va_list ap;
-    va_start(ap, format);
+    size_t count = size / CHUNK_CAPACITY + 1;
+    if (count > l->threads * CHUNKS_PER_THREAD)
+        count = l->threads * CHUNKS_PER_THREAD;
 
-    // Try to get long from user
-    while (true)
+    // Split bytes after first line ending past each share of bytes
+    size_t chunked = 0;
+    for (size_t i = 0; i < size; chunked++)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return LONG_MAX; // Return sentinel value on error
-        }
+        size_t end = size / count * (chunked + 1);
+        end = chunked + 1 == count ? size : skip_line(bytes, size, end > i ? end - 1 : i);
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+        l->chunks[chunked].bytes = bytes + i;
+        l->chunks[chunked].size = end - i;
+        i = end;
+    }
 
-        if (*str == '\0') // Check for empty string
-            continue;
+    begin_stage(l, STAGE_COUNT, chunked);
+    end_stage(l);
 
-        errno = 0;
-        char *end;
-        long val = strtol(str, &end, 10); // Convert string to long
+    // Number lines of each chunk from lines of every batch before
+    size_t lines = l->count;
+    for (size_t k = 0; k < l->chunked; k++)
+    {
+        l->chunks[k].first = lines;
+        lines += l->chunks[k].count;
+    }
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+    double *values = reserve(l->values, &l->capacity, lines * sizeof(double));
+    if (lines > 0 && values == NULL)
+        return false;
+    l->values = values;
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val >= LONG_MIN && val <= LONG_MAX)
-        {
-            va_end(ap);
-            return val; // Return long
-        }
-    }
+    begin_stage(l, STAGE_PARSE, chunked);
+    return true;
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return unsigned long value. If string does not represent unsigned long in [0, ULONG_MAX], prompt user to retry
-// Return ULONG_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-unsigned long get_unsigned_long(const char *format, ...)
+// Wait until every chunk of batch is parsed, and append line numbers of rejected lines of each chunk
+// Return false on errors
+static bool end_batch(load *l)
 {
-    va_list ap;
-    va_start(ap, format);
+    end_stage(l);
 
-    // Try to get unsigned long from user
-    while (true)
+    for (size_t k = 0; k < l->chunked; k++)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
+        chunk *c = &l->chunks[k];
+        if (c->failed)
+            return false;
+
+        if (c->rejected > 0)
         {
-            va_end(ap);
-            return ULONG_MAX; // Return sentinel value on error
+            size_t *errors = reserve(l->errors, &l->room, (l->rejected + c->rejected) * sizeof(size_t));
+            if (errors == NULL)
+                return false;
+            l->errors = errors;
+
+            memcpy(l->errors + l->rejected, c->errors, c->rejected * sizeof(size_t));
+            l->rejected += c->rejected;
         }
+        l->count += c->count;
+    }
+    return true;
+}
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+// Read bytes into buffer until it holds want bytes or input ends, growing buffer to want bytes first
+// Return false on errors
+static bool gather(reader *r, unsigned char **buffer, size_t *capacity, size_t *size, size_t want)
+{
+    unsigned char *temp = reserve(*buffer, capacity, want);
+    if (temp == NULL)
+        return false;
+    *buffer = temp;
 
-        if (*str == '\0') // Check for empty string
-            continue;
+    while (*size < want && !r->eof)
+    {
+        ptrdiff_t n = pull(r, *buffer + *size, *capacity - *size);
+        if (n <= 0) // Keep EOF sticky like stdio
+            r->eof = true;
+        else
+            *size += (size_t)n;
+    }
+    return true;
+}
 
-        if (*str == '-') // Reject negative value
-            continue;
+// Read every remaining line of reader as double, parsing chunks of lines on threads kept for every batch
+// Parse mapped regular file or bytes in memory in place, in batches of whole lines, so lines are parsed while still in cache
+// Read streamed input into two buffers in turn, reading next batch while threads parse batch before
+// Return values on heap in order of lines, or NULL on errors or no input (EOF)
+static double *read_doubles(reader *r, size_t *count, size_t **errors, size_t *rejected, size_t threads)
+{
+    load l = {.lock = MUTEX_INITIALISER, .started = CONDITION_INITIALISER, .finished = CONDITION_INITIALISER};
+    l.threads = threads > 0 ? threads : processors();
+    l.chunks = calloc(l.threads * CHUNKS_PER_THREAD, sizeof(chunk));
+    l.ids = malloc(l.threads * sizeof(thread));
+    l.capped = r->capped;
+    l.limit = r->limit;
+    l.policy = r->policy;
+    bool ok = l.chunks != NULL && l.ids != NULL;
 
-        errno = 0;
-        char *end;
-        unsigned long val = strtoul(str, &end, 10); // Convert string to unsigned long
+    // Probe source for single block in memory or mapped regular file
+    if (ok && r->start == r->end && !r->probed)
+        fill(r);
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+    unsigned char *buffers[2] = {NULL, NULL};
+    size_t capacities[2] = {0, 0};
+    if (ok && r->block != NULL && r->block != r->buffer) // Parse rest of block in place
+    {
+        if (r->cr && r->start < r->end) // Skip LF of CRLF (\r\n) left by previous line
+        {
+            r->cr = false;
+            if (r->block[r->start] == '\n')
+                r->start++;
+        }
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val <= ULONG_MAX)
+        const unsigned char *bytes = r->block + r->start;
+        size_t size = r->end - r->start;
+        for (size_t i = 0; ok && i < size;)
         {
-            va_end(ap);
-            return val; // Return unsigned long
+            size_t end = size - i > LOAD_CAPACITY ? skip_line(bytes, size, i + LOAD_CAPACITY - 1) : size;
+            ok = begin_batch(&l, bytes + i, end - i) && end_batch(&l);
+            i = end;
         }
+
+        if (r->start < r->end)
+            r->cr = r->block[r->end - 1] == '\r';
+        r->start = r->end;
     }
-}
+    else if (ok) // Read batches of whole lines, starting with unread bytes of block
+    {
+        size_t size = r->end - r->start, want = LOAD_CAPACITY;
+        ok = (buffers[0] = reserve(NULL, &capacities[0], size > want ? size : want)) != NULL;
+        if (ok && size > 0)
+            memcpy(buffers[0], r->block + r->start, size);
+        r->start = r->end;
 
-// Prompt user for line of characters from standard input using get_string function
-// Return long long value. If string does not represent long long in [LLONG_MIN, LLONG_MAX], prompt user to retry
-// Return LLONG_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-long long get_long_long(const char *format, ...)
-{
-    va_list ap;
-    va_start(ap, format);
+        bool skip = r->cr;
+        r->cr = false;
 
-    // Try to get long long from user
-    while (true)
-    {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
+        // Show prompts and output held in buffer of standard output before waiting for standard input
+        if (output != OUTPUT_UNBUFFERED && r == &input)
+            fflush(stdout);
+
+        bool dropping = false; // Indicate rest of long line is discarded up to its line ending
+        for (size_t b = 0; ok; b = !b)
         {
-            va_end(ap);
-            return LLONG_MAX; // Return sentinel value on error
-        }
+            // Read until batch is full or input ends, growing batch for line longer than batch
+            size_t cut = 0;
+            while (ok)
+            {
+                if (!(ok = gather(r, &buffers[b], &capacities[b], &size, want)))
+                    break;
+                if (skip && size > 0) // Skip LF of CRLF (\r\n) left by previous line
+                {
+                    skip = false;
+                    if (buffers[b][0] == '\n')
+                        memmove(buffers[b], buffers[b] + 1, --size);
+                }
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+                if (dropping) // Discard characters of long line beyond characters kept, up to its line ending
+                {
+                    size_t kept = r->limit + 1, end = size;
+                    const unsigned char *found = scan(buffers[b] + kept, size - kept);
+                    if (found != NULL)
+                    {
+                        end = (size_t)(found - buffers[b]);
+                        memmove(buffers[b] + kept, found, size - end);
+                        dropping = false;
+                    }
+                    size -= end - kept;
+                }
 
-        if (*str == '\0') // Check for empty string
-            continue;
+                cut = r->eof ? size : last_line(buffers[b], size);
+                if (cut == 0 && size > 0 && buffers[b][size - 1] == '\r') // Cut after CR (\r), skipping LF of CRLF (\r\n) in next batch
+                {
+                    cut = size;
+                    skip = true;
+                }
+                if (cut > 0 || r->eof)
+                    break;
 
-        errno = 0;
-        char *end;
-        long long val = strtoll(str, &end, 10); // Convert string to long long
+                if (r->capped && r->limit + 1 < want) // Keep characters of line within limit and one more to mark it long
+                {
+                    size = r->limit + 1;
+                    dropping = true;
+                    continue;
+                }
+                ok = want < SIZE_MAX / 2;
+                want *= 2;
+            }
+            if (!ok || !begin_batch(&l, buffers[b], cut))
+            {
+                ok = false;
+                break;
+            }
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+            // Move partial line into other buffer, and read next batch there while threads parse this batch
+            size -= cut;
+            unsigned char *temp = reserve(buffers[!b], &capacities[!b], size > want ? size : want);
+            ok = temp != NULL;
+            if (ok)
+            {
+                buffers[!b] = temp;
+                memcpy(buffers[!b], buffers[b] + cut, size);
+                ok = gather(r, &buffers[!b], &capacities[!b], &size, want);
+            }
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val >= LLONG_MIN && val <= LLONG_MAX)
-        {
-            va_end(ap);
-            return val; // Return long long
+            ok = end_batch(&l) && ok;
+            if (r->eof && size == 0)
+                break;
         }
     }
+
+    // Stop threads, and free buffers of batches
+    if (l.spawned > 0)
+    {
+        begin_stage(&l, STAGE_STOP, 0);
+        for (size_t t = 0; t < l.spawned; t++)
+            join(l.ids[t]);
+    }
+    free(buffers[0]);
+    free(buffers[1]);
+    for (size_t k = 0; l.chunks != NULL && k < l.threads * CHUNKS_PER_THREAD; k++)
+        free(l.chunks[k].errors);
+    free(l.chunks);
+    free(l.ids);
+
+    if (!ok || l.count == 0) // Check for errors or no input from user
+    {
+        r->status = ok ? INPUT_EOF : INPUT_ALLOC;
+        free(l.values);
+        free(l.errors);
+        l.values = NULL;
+        l.errors = NULL;
+        l.count = 0;
+        l.rejected = 0;
+    }
+    else // Shrink values to fit
+    {
+        double *values = realloc(l.values, l.count * sizeof(double));
+        if (values != NULL)
+            l.values = values;
+        STAT(lines, l.count);
+    }
+
+    *count = l.count;
+    if (errors != NULL)
+        *errors = l.errors;
+    else
+        free(l.errors);
+    if (rejected != NULL)
+        *rejected = l.rejected;
+    return l.values;
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return unsigned long long value. If string does not represent unsigned long long in [0, ULLONG_MAX], prompt user to retry
-// Return ULLONG_MAX as sentinel value if string cannot be read
-// Format prompt like printf(3) function for user
-unsigned long long get_unsigned_long_long(const char *format, ...)
+// Read every remaining line of stream as double, or of standard input if stream is NULL, parsing chunks of lines on threads
+// Return values on heap in order of lines, freed by caller with free(3), and store number of lines in count
+// Store DBL_MAX for each line rejected by get_double function instead of retrying
+// Store line numbers of rejected lines from 1 on heap in errors, freed by caller, and their number in rejected (if not NULL)
+// Use number of processors if threads is 0, and line limit of stream without buffering characters of long line beyond it
+// Return NULL on errors or no input (EOF), with status INPUT_ALLOC or INPUT_EOF
+double *load_doubles(stream *s, size_t *count, size_t **errors, size_t *rejected, size_t threads)
 {
-    va_list ap;
-    va_start(ap, format);
+    reader *r = acquire(s);
+    double *values = read_doubles(r, count, errors, rejected, threads);
+    relinquish(r);
+    return values;
+}
 
-    // Try to get unsigned long long from user
-    while (true)
-    {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return ULLONG_MAX; // Return sentinel value on error
-        }
+// Define maximum number of blocks read by each call of pump_input function, so event loop serves other sources
+#define PUMP_READS 16
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+// Define pump of input with its own block reader, emitting value of each complete line
+struct pump
+{
+    reader reader;          // Block reader holding file descriptor, line buffer, and CR of CRLF pair between calls
+    size_t pending;         // Number of characters of partial line in line buffer
+    pump_type type;         // Type of values emitted
+    pump_callback callback; // Function of caller for each complete line
+    void *context;          // Argument of callback
+    bool ended;             // Indicate end of input was reached
+    struct pump *prev;      // Previous pump in list of pumps
+    struct pump *next;      // Next pump in list of pumps
+};
 
-        if (*str == '\0') // Check for empty string
-            continue;
+// Initialise list of pumps
+static pump *pumps = NULL;
 
-        if (*str == '-') // Reject negative value
-            continue;
+// Initialise parsers of numeric types emitted by pumps, like typed wrapper functions
+static const element pump_elements[] = {
+    [PUMP_INT] = int_element,
+    [PUMP_UNSIGNED_INT] = unsigned_int_element,
+    [PUMP_LONG] = long_element,
+    [PUMP_UNSIGNED_LONG] = unsigned_long_element,
+    [PUMP_LONG_LONG] = long_long_element,
+    [PUMP_UNSIGNED_LONG_LONG] = unsigned_long_long_element,
+    [PUMP_FLOAT] = float_element,
+    [PUMP_DOUBLE] = double_element,
+    [PUMP_LONG_DOUBLE] = long_double_element,
+};
 
-        errno = 0;
-        char *end;
-        unsigned long long val = strtoull(str, &end, 10); // Convert string to unsigned long long
+// Create pump of file descriptor for event loops, emitting values of type to callback with context
+// Return NULL on errors
+pump *create_pump(int fd, pump_type type, pump_callback callback, void *context)
+{
+    if (type < PUMP_LINE || type > PUMP_LONG_DOUBLE || callback == NULL)
+        return NULL;
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+    pump *p = calloc(1, sizeof(pump));
+    if (p == NULL)
+        return NULL;
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && val <= ULLONG_MAX)
-        {
-            va_end(ap);
-            return val; // Return unsigned long long
-        }
-    }
+    p->reader = (reader){.kind = SOURCE_FD, .fd = fd};
+    p->type = type;
+    p->callback = callback;
+    p->context = context;
+
+    // Prepend pump to list of pumps
+    lock(&shared);
+    p->prev = NULL;
+    p->next = pumps;
+    if (pumps != NULL)
+        pumps->prev = p;
+    pumps = p;
+    unlock(&shared);
+    return p;
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return float value. If string does not represent float in [-FLT_MAX, FLT_MAX], prompt user to retry
-// Return FLT_MAX as sentinel value if string cannot be read
-// Ignore finite subnormal numbers
-// Format prompt like printf(3) function for user
-float get_float(const char *format, ...)
+// Set maximum number of characters of each line of pump, and policy for longer lines, like set_line_limit function
+// Emit lines of any length if limit is SIZE_MAX
+void set_pump_line_limit(pump *p, size_t limit, line_policy policy)
 {
-    va_list ap;
-    va_start(ap, format);
+    p->reader.capped = limit != SIZE_MAX;
+    p->reader.limit = limit;
+    p->reader.policy = policy;
+}
 
-    // Try to get float from user
-    while (true)
-    {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
-        {
-            va_end(ap);
-            return FLT_MAX; // Return sentinel value on error
-        }
+// Free pump and its buffers, without closing its file descriptor
+void destroy_pump(pump *p)
+{
+    if (p == NULL)
+        return;
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+    // Unlink pump from list of pumps
+    lock(&shared);
+    if (p->prev != NULL)
+        p->prev->next = p->next;
+    else
+        pumps = p->next;
+    if (p->next != NULL)
+        p->next->prev = p->prev;
+    unlock(&shared);
 
-        if (*str == '\0') // Check for empty string
-            continue;
+    close_reader(&p->reader);
+    free(p);
+}
 
-        errno = 0;
-        char *end;
-        float val = strtof(str, &end); // Convert string to float
+// Parse line as value of type of pump, or reject long line, and pass value and line to callback
+static void emit(pump *p, const char *str, size_t size, bool rejected)
+{
+    union
+    {
+        int i;
+        unsigned int ui;
+        long l;
+        unsigned long ul;
+        long long ll;
+        unsigned long long ull;
+        float f;
+        double d;
+        long double ld;
+    } value;
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+    line_view line = {str, size};
+    const char *zero = memchr(str, '\0', size); // End line at first '\0' like typed wrapper functions
+    if (zero != NULL)
+        size = zero - str;
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && isfinite(val) && val >= -FLT_MAX && val <= FLT_MAX)
-        {
-            va_end(ap);
-            return val; // Return float
-        }
-    }
+    bool valid = p->type != PUMP_LINE && !rejected && PARSE(pump_elements[p->type](&p->reader, str, size, &value)) == INPUT_OK;
+    STAT(lines, 1);
+    p->callback(p->context, valid ? &value : NULL, line);
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return double value. If string does not represent double in [-DBL_MAX, DBL_MAX], prompt user to retry
-// Return DBL_MAX as sentinel value if string cannot be read
-// Ignore finite subnormal numbers
-// Format prompt like printf(3) function for user
-double get_double(const char *format, ...)
+// Emit line of pump under policy for line longer than limit of pump, dropping discarded line
+// Return number of lines emitted
+static ptrdiff_t deliver(pump *p, const char *str, size_t size)
 {
-    va_list ap;
-    va_start(ap, format);
+    line_policy policy = verdict(&p->reader);
+    if (policy == LINE_DISCARD)
+        return 0;
+    emit(p, str, size, policy == LINE_REJECT);
+    return 1;
+}
 
-    // Try to get float from user
-    while (true)
+// Split bytes into lines, emitting complete lines in place and keeping partial line in line buffer
+// Keep at most limit characters of each line if capped, discarding characters beyond limit without buffering them
+// Support CR (\r), LF (\n), and CRLF (\r\n) as line endings, carrying CR of CRLF pair split between calls
+// Return number of lines emitted, or -1 on errors
+static ptrdiff_t split(pump *p, const unsigned char *bytes, size_t size)
+{
+    reader *r = &p->reader;
+    ptrdiff_t emitted = 0;
+    for (size_t i = 0; i < size;)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
+        if (r->cr) // Skip LF of CRLF (\r\n) left by previous line
         {
-            va_end(ap);
-            return DBL_MAX; // Return sentinel value on error
+            r->cr = false;
+            if (bytes[i] == '\n')
+            {
+                i++;
+                continue;
+            }
         }
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
-
-        if (*str == '\0') // Check for empty string
-            continue;
-
-        errno = 0;
-        char *end;
-        double val = strtod(str, &end); // Convert string to double
+        // Find line ending in rest of bytes
+        const unsigned char *found = scan(bytes + i, size - i);
+        size_t n = found != NULL ? (size_t)(found - bytes) - i : size - i;
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+        size_t kept = n;
+        if (r->capped && p->pending + n > r->limit) // Mark long line, keeping characters within limit
+        {
+            kept = p->pending < r->limit ? r->limit - p->pending : 0;
+            r->overlong = true;
+        }
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && isfinite(val) && val >= -DBL_MAX && val <= DBL_MAX)
+        if (found == NULL || p->pending > 0) // Append segment to partial line
         {
-            va_end(ap);
-            return val; // Return double
+            unsigned char *temp = reserve(r->line, &r->capacity, p->pending + kept);
+            if (temp == NULL)
+                return -1;
+            r->line = temp;
+
+            memcpy(r->line + p->pending, bytes + i, kept);
+            p->pending += kept;
         }
+        if (found == NULL)
+            break;
+
+        // Emit line from line buffer, or in place without copying
+        if (p->pending > 0)
+            emitted += deliver(p, (const char *)r->line, p->pending);
+        else
+            emitted += deliver(p, (const char *)bytes + i, kept);
+        p->pending = 0;
+
+        r->cr = *found == '\r'; // Check for CRLF (\r\n) in next bytes
+        i += n + 1;
     }
+    return emitted;
 }
 
-// Prompt user for line of characters from standard input using get_string function
-// Return long double value. If string does not represent long double in [-LDBL_MAX, LDBL_MAX], prompt user to retry
-// Return LDBL_MAX as sentinel value if string cannot be read
-// Ignore finite subnormal numbers
-// Format prompt like printf(3) function for user
-long double get_long_double(const char *format, ...)
+// Emit partial line at end of input
+// Return number of lines emitted
+static ptrdiff_t finish(pump *p)
 {
-    va_list ap;
-    va_start(ap, format);
+    p->ended = true;
+    if (p->pending == 0 && !p->reader.overlong) // Check for partial line, or long line with no characters kept
+        return 0;
 
-    // Try to get float from user
-    while (true)
+    ptrdiff_t emitted = deliver(p, p->pending > 0 ? (const char *)p->reader.line : "", p->pending);
+    p->pending = 0;
+    return emitted;
+}
+
+// Read bytes ready on file descriptor of pump without blocking, emitting value of each complete line
+// Return number of values emitted, or -1 at end of input or errors, after emitting last line without line ending
+ptrdiff_t pump_input(pump *p)
+{
+    reader *r = &p->reader;
+    if (p->ended)
+        return -1;
+    COUNTING();
+
+    // Allocate block on first read
+    if (r->buffer == NULL)
     {
-        char *str = get_string(&ap, format); // Get line of characters
-        if (str == NULL)
+        r->buffer = malloc(BLOCK_CAPACITY);
+        if (r->buffer == NULL)
+            return -1;
+    }
+
+    ptrdiff_t emitted = 0;
+    for (size_t reads = 0; reads < PUMP_READS; reads++)
+    {
+#ifdef POLL_INPUT
+        struct pollfd ready = {.fd = r->fd, .events = POLLIN};
+        if (poll(&ready, 1, 0) == 0) // Stop when no bytes are ready
+            break;
+#endif
+
+        ptrdiff_t n = pull(r, r->buffer, BLOCK_CAPACITY);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) // Stop when non-blocking file descriptor has no bytes
+            break;
+        if (n <= 0)
         {
-            va_end(ap);
-            return LDBL_MAX; // Return sentinel value on error
+            finish(p);
+            return -1;
         }
 
-        while (isspace((unsigned char)*str)) // Trim leading whitespace
-            str++;
+        ptrdiff_t lines = split(p, r->buffer, (size_t)n);
+        if (lines < 0)
+            return -1;
+        emitted += lines;
 
-        if (*str == '\0') // Check for empty string
-            continue;
+#ifndef POLL_INPUT
+        break; // Read once, since readiness cannot be checked
+#endif
+    }
+    return emitted;
+}
 
-        errno = 0;
-        char *end;
-        long double val = strtold(str, &end); // Convert string to long double
+// Feed bytes to pump, emitting value of each complete line, or end input if size is 0
+// Return number of values emitted, or -1 on errors or after end of input
+ptrdiff_t pump_bytes(pump *p, const char *bytes, size_t size)
+{
+    if (p->ended)
+        return -1;
+    COUNTING();
+    STAT(bytes, size);
+    return size > 0 ? split(p, (const unsigned char *)bytes, size) : finish(p);
+}
 
-        while (isspace((unsigned char)*end)) // Trim trailing whitespace
-            end++;
+// Initialise file for statistics written at program exit, or NULL for none
+static FILE *stats_dump = NULL;
 
-        // Check remaining string and range
-        if (errno == 0 && *end == '\0' && isfinite(val) && val >= -LDBL_MAX && val <= LDBL_MAX)
-        {
-            va_end(ap);
-            return val; // Return long double
-        }
-    }
+// Store snapshot of statistics summed over every thread in stats, counted only if library is compiled with STDPROMPT_STATS
+// Return false and store zeros if statistics are compiled out
+bool get_stats(input_stats *stats)
+{
+    *stats = (input_stats){0};
+#ifdef STDPROMPT_STATS
+    lock(&shared);
+    *stats = retired;
+    for (local *l = locals; l != NULL; l = l->next)
+        add_stats(stats, &l->stats);
+    unlock(&shared);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Write statistics of library to file at program exit, or nothing if file is NULL
+void set_stats_dump(FILE *file)
+{
+    stats_dump = file;
+}
+
+// Write statistics of library to file, one counter on each line
+static void dump_stats(FILE *file)
+{
+    static const char *getters[STATS_GETTERS] = {"char", "unsigned_char", "int", "unsigned_int", "long", "unsigned_long",
+                                                 "long_long", "unsigned_long_long", "float", "double", "long_double"};
+
+    input_stats stats;
+    if (!get_stats(&stats))
+        return;
+
+    fprintf(file, "stdprompt: lines %zu\n", stats.lines);
+    fprintf(file, "stdprompt: bytes %zu\n", stats.bytes);
+    fprintf(file, "stdprompt: reads %zu\n", stats.reads);
+    fprintf(file, "stdprompt: grows %zu\n", stats.grows);
+    fprintf(file, "stdprompt: strings %zu\n", stats.strings);
+    fprintf(file, "stdprompt: pages %zu\n", stats.pages);
+    fprintf(file, "stdprompt: expansions %zu\n", stats.expansions);
+    for (size_t i = 0; i < STATS_GETTERS; i++)
+        if (stats.retries[i] > 0)
+            fprintf(file, "stdprompt: retries get_%s %zu\n", getters[i], stats.retries[i]);
+    fprintf(file, "stdprompt: read_ms %.3f\n", stats.read_ns / 1e6);
+    fprintf(file, "stdprompt: parse_ms %.3f\n", stats.parse_ns / 1e6);
+    fflush(file);
 }
 
 // Call automatically after execution exit main program
 static void teardown(void)
 {
-    if (strings != NULL)
+    if (stats_dump != NULL) // Write statistics before freeing state of threads
+        dump_stats(stats_dump);
+
+    self = NULL; // Stop counting into state of main thread, freed below with every other state
+    lock(&shared); // Take list of states from exit hooks of threads still running
+    local *list = locals;
+    locals = NULL;
+    unlock(&shared);
+    while (list != NULL) // Free allocated strings, registry, and rendered prompt of every thread
     {
-        for (size_t i = 0; i < allocations; i++)
-            free(strings[i]); // Free allocated strings
-        free(strings);        // Free dynamic array
+        local *l = list;
+        list = l->next;
+        release(&l->strings);
+        free(l->cache.text);
+        free(l);
     }
+
+    while (arenas != NULL) // Free arenas and their strings
+        destroy_arena(arenas);
+
+    while (streams != NULL) // Free streams and their buffers
+        destroy_stream(streams);
+
+    while (pumps != NULL) // Free pumps and their buffers
+        destroy_pump(pumps);
+
+    close_reader(&input); // Free buffers of standard input and unmap its file
 }
 
 // Define portable INITIALISER(FUNC) macro to run FUNC before main program
@@ -639,10 +4679,22 @@ static void teardown(void)
 // Call automatically before execution enters main program
 INITIALISER(setup)
 {
-    // Disable buffering for standard output
-    setvbuf(stdout, NULL, _IONBF, 0);
+    // Buffer standard output by line on terminal, and fully otherwise
+    set_output_mode(OUTPUT_AUTO);
+
+    // Select fastest line ending kernel supported by CPU
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+        scan = scan_avx512;
+    else if (__builtin_cpu_supports("avx2"))
+        scan = scan_avx2;
+    else if (__builtin_cpu_supports("sse2"))
+        scan = scan_sse2;
+#endif
 
-    // Free memory for dynamic array of allocated strings
+    // Free state of each thread at its exit, and memory for registry of allocated strings at program exit
+    hooked = hook_exit(&leaving, leave);
     atexit(teardown);
 }
 
@@ -2,10 +2,88 @@
 #define STDPROMPT_H
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <limits.h>
 #include <float.h>
 
+// Export every function declared below from shared library built with -fvisibility=hidden
+#if defined(__GNUC__)
+#pragma GCC visibility push(default)
+#endif
+
+// Call every function from any thread: each call from standard input holds its lock until it returns,
+// and each thread keeps its own strings, arena in use, and rendered prompt
+// Free state of thread at its exit, but keep thread's strings not yet freed until program exit
+// Use each stream and arena from one thread at a time, and set policies before starting threads
+
+// Define opaque stream of input with its own buffers and state, for reading from sources other than standard input
+// Pass stream to _from variant of each function, or NULL to read from standard input
+typedef struct stream stream;
+
+// Define pointer type for callback of stream, storing up to capacity bytes of input in buffer
+// Return number of bytes stored, 0 at end of input, or negative value on errors
+typedef ptrdiff_t (*stream_callback)(void *context, char *buffer, size_t capacity);
+
+// Create stream reading lines from FILE stream, leaving stream at start of next line after each read
+// Read character after CR (\r) to tell CRLF (\r\n) apart, putting it back with ungetc(3) otherwise
+// Return NULL on errors
+stream *create_file_stream(FILE *file);
+
+// Create stream reading blocks from file descriptor, or mapping it if it is regular file (POSIX)
+// Return NULL on errors
+stream *create_fd_stream(int fd);
+
+// Create stream reading size bytes in memory without copying them, so memory must outlive stream
+// Return NULL on errors
+stream *create_memory_stream(const char *data, size_t size);
+
+// Create stream reading blocks from callback, called with context, buffer, and capacity of buffer
+// Return NULL on errors
+stream *create_callback_stream(stream_callback callback, void *context);
+
+// Free stream and its buffers, without closing its file, file descriptor, or memory
+// Library destructor frees streams left on program exit
+void destroy_stream(stream *s);
+
+// Define status of last call reading input in calling thread
+typedef enum input_status
+{
+    INPUT_OK,        // Input read
+    INPUT_EOF,       // No input (EOF) or read errors
+    INPUT_TIMEOUT,   // No complete line before deadline of call
+    INPUT_EXHAUSTED, // Every retry allowed by set_limits function rejected
+    INPUT_ALLOC,     // Memory allocation failed
+    INPUT_RANGE,     // Number out of range of type
+    INPUT_SYNTAX,    // Line does not represent value of type
+    INPUT_LONG       // Line longer than limit rejected
+} input_status;
+
+// Set deadline in milliseconds of each call reading stream, or standard input if stream is NULL (POSIX file descriptors)
+// and maximum number of retries of typed functions before returning sentinel value
+// Wait forever if timeout is negative (default), and retry forever if retries is SIZE_MAX (default)
+// Keep partial line on timeout, so next call resumes it
+void set_limits(stream *s, int timeout, size_t retries);
+
+// Return status of last call reading input in calling thread, to tell sentinel value from timeout, exhausted retries,
+// or allocation failure, and why try_get functions rejected line. Leave status unchanged by set_limits and set_line_limit functions
+input_status get_status(void);
+
+// Define policy for lines longer than limit
+typedef enum line_policy
+{
+    LINE_TRUNCATE, // Keep first limit characters of line
+    LINE_REJECT,   // Fail call with INPUT_LONG status, so typed functions return sentinel value
+    LINE_DISCARD   // Drop line and read next line
+} line_policy;
+
+// Set maximum number of characters of each line read from stream, or standard input if stream is NULL, and policy for longer lines
+// Discard characters beyond limit up to line ending without buffering them, so hostile line cannot exhaust memory
+// Read lines of any length if limit is SIZE_MAX (default). Cover string, line view, typed, and array functions, and load_doubles function
+void set_line_limit(stream *s, size_t limit, line_policy policy);
+
 // Prompt user for line of characters from standard input
 // Return string (char *) value. If user inputs only line ending, returns "" not NULL
 // Support CR (Mac OS), LF (Linux), and CRLF (Windows) as line endings
@@ -15,73 +93,433 @@
 char *get_string(va_list *args, const char *format, ...) __attribute__((format(printf, 2, 3)));
 #define get_string(...) get_string(NULL, __VA_ARGS__)
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_string function, or from standard input if stream is NULL
+char *get_string_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Define view of line in buffer of library, not terminated by '\0'
+typedef struct line_view
+{
+    const char *data; // First character of line, or NULL on errors or no input (EOF)
+    size_t size;      // Number of characters in line
+} line_view;
+
+// Prompt user for line of characters from standard input without copying it
+// Return view of line, valid until next read. If user inputs only line ending, returns empty view with non-NULL data
+// Support CR (Mac OS), LF (Linux), and CRLF (Windows) as line endings
+// Return view with NULL data on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+line_view get_line_view(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+// Prompt user for input from stream like get_line_view function, or from standard input if stream is NULL
+// Return view valid until next read from same stream, or from standard input in any thread
+line_view get_line_view_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Define function receiving piece of line from get_line_chunks function, with last true for final piece of line
+typedef void (*chunk_callback)(void *context, const char *data, size_t size, bool last);
+
+// Prompt user for line of characters from stream, or from standard input if stream is NULL, without buffering whole line
+// Pass line to callback in pieces of size bytes, last piece shorter and marked as last, for lines of any length
+// Ignore line limit, and pass pieces read before timeout, so next call passes rest of line
+// Return INPUT_OK, or INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, or INPUT_RANGE if size is 0
+// Format prompt like printf(3) function for user
+input_status get_line_chunks(stream *s, size_t size, chunk_callback callback, void *context, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Free string allocated on heap by get_string function in calling thread, before program exit
+// Ignore NULL and strings already freed
+// String must come from get_string function in calling thread, not from arena
+void free_string(char *str);
+
+// Return mark of strings allocated on heap by get_string function in calling thread so far
+size_t checkpoint_strings(void);
+
+// Free every string allocated on heap by get_string function in calling thread since mark
+void rollback_strings(size_t mark);
+
+// Keep only last limit strings allocated on heap by get_string function in calling thread, freeing older strings
+// Keep every string if limit is 0 (default)
+void keep_strings(size_t limit);
+
+// Define opaque arena of strings allocated by get_string function
+typedef struct arena arena;
+
+// Create arena for strings allocated by get_string function
+// Pack strings one after another in large slabs instead of separate heap allocations
+// Return NULL on errors
+// Library destructor frees arenas left on program exit
+arena *create_arena(void);
+
+// Free every string in arena, keeping arena for next batch of strings
+void reset_arena(arena *a);
+
+// Free arena and every string in it
+// Return get_string function to heap if arena is in use by calling thread
+void destroy_arena(arena *a);
+
+// Allocate strings from get_string function in calling thread in arena, or on heap if arena is NULL
+// Return arena previously in use, or NULL for heap
+arena *use_arena(arena *a);
+
+// Define buffering policies for standard output
+typedef enum output_mode
+{
+    OUTPUT_AUTO,       // Line buffering if standard output is terminal, otherwise full buffering (default)
+    OUTPUT_UNBUFFERED, // Write every character immediately
+    OUTPUT_LINE,       // Write at every newline
+    OUTPUT_FULL        // Write when buffer is full
+} output_mode;
+
+// Set buffering of standard output, resolving OUTPUT_AUTO to line buffering on terminal and full buffering otherwise
+// Flush standard output before each read from standard input if output is buffered, so prompts always appear
+// Return policy previously in use
+output_mode set_output_mode(output_mode mode);
+
+// Define policies for prompts of every function
+typedef enum prompt_mode
+{
+    PROMPT_AUTO, // Show prompts only if standard input is terminal
+    PROMPT_SHOW, // Show prompts (default)
+    PROMPT_SKIP  // Skip prompts, for input from files and pipes that nobody sees
+} prompt_mode;
+
+// Set prompts of every function, resolving PROMPT_AUTO to showing prompts only if standard input is terminal
+// Return policy previously in use
+prompt_mode set_prompt_mode(prompt_mode mode);
+
+// Define typed functions with retries counted separately in statistics
+typedef enum stats_getter
+{
+    STATS_CHAR,               // get_char functions
+    STATS_UNSIGNED_CHAR,      // get_unsigned_char functions
+    STATS_INT,                // get_int functions
+    STATS_UNSIGNED_INT,       // get_unsigned_int functions
+    STATS_LONG,               // get_long functions
+    STATS_UNSIGNED_LONG,      // get_unsigned_long functions
+    STATS_LONG_LONG,          // get_long_long functions
+    STATS_UNSIGNED_LONG_LONG, // get_unsigned_long_long functions
+    STATS_FLOAT,              // get_float functions
+    STATS_DOUBLE,             // get_double functions
+    STATS_LONG_DOUBLE,        // get_long_double functions
+    STATS_GETTERS             // Number of typed functions counted
+} stats_getter;
+
+// Define snapshot of statistics of library, summed over every thread
+typedef struct input_stats
+{
+    size_t lines;                  // Lines returned, viewed, passed to callbacks, emitted by pumps, or loaded
+    size_t bytes;                  // Bytes read from sources, mapped, or fed to pumps
+    size_t reads;                  // Reads from file descriptors, FILE streams, and callbacks
+    size_t grows;                  // Reallocations growing buffer of get_string functions
+    size_t strings;                // Strings stored in registries and not yet freed
+    size_t pages;                  // Pages of string pointers allocated by registries
+    size_t expansions;             // Reallocations growing directories of registries
+    size_t retries[STATS_GETTERS]; // Lines rejected by each typed function before retrying
+    uint64_t read_ns;              // Nanoseconds blocked in reads and waiting for input
+    uint64_t parse_ns;             // Nanoseconds parsing lines by typed, try, and array functions, and by pumps
+} input_stats;
+
+// Store snapshot of statistics of library in stats (not NULL), counted only if library is compiled with STDPROMPT_STATS
+// Include threads still running, whose counters may lag by calls in progress
+// Return false and store zeros if statistics are compiled out
+bool get_stats(input_stats *stats);
+
+// Write statistics of library to file at program exit, or nothing if file is NULL (default)
+// Write nothing if statistics are compiled out
+void set_stats_dump(FILE *file);
+
+// Prompt user for line of characters from standard input without allocating
 // Return char value. If string does not represent single char, prompt user to retry
 // Return CHAR_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 char get_char(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_char function, or from standard input if stream is NULL
+char get_char_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return unsigned char value. If string does not represent single char, prompt user to retry
 // Return UCHAR_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 unsigned char get_unsigned_char(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_unsigned_char function, or from standard input if stream is NULL
+unsigned char get_unsigned_char_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return int value. If string does not represent int in [INT_MIN, INT_MAX], prompt user to retry
 // Return INT_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 int get_int(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_int function, or from standard input if stream is NULL
+int get_int_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return unsigned int value. If string does not represent unsigned int in [0, UINT_MAX], prompt user to retry
 // Return UINT_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 unsigned int get_unsigned_int(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_unsigned_int function, or from standard input if stream is NULL
+unsigned int get_unsigned_int_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return long value. If string does not represent long in [LONG_MIN, LONG_MAX], prompt user to retry
 // Return LONG_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 long get_long(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_long function, or from standard input if stream is NULL
+long get_long_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return unsigned long value. If string does not represent unsigned long in [0, ULONG_MAX], prompt user to retry
 // Return ULONG_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 unsigned long get_unsigned_long(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_unsigned_long function, or from standard input if stream is NULL
+unsigned long get_unsigned_long_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return long long value. If string does not represent long long in [LLONG_MIN, LLONG_MAX], prompt user to retry
 // Return LLONG_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 long long get_long_long(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_long_long function, or from standard input if stream is NULL
+long long get_long_long_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return unsigned long long value. If string does not represent unsigned long long in [0, ULLONG_MAX], prompt user to retry
 // Return ULLONG_MAX as sentinel value if string cannot be read
 // Format prompt like printf(3) function for user
 unsigned long long get_unsigned_long_long(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_unsigned_long_long function, or from standard input if stream is NULL
+unsigned long long get_unsigned_long_long_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return float value. If string does not represent float in [-FLT_MAX, FLT_MAX], prompt user to retry
 // Return FLT_MAX as sentinel value if string cannot be read
 // Ignore finite subnormal numbers
 // Format prompt like printf(3) function for user
 float get_float(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_float function, or from standard input if stream is NULL
+float get_float_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return double value. If string does not represent double in [-DBL_MAX, DBL_MAX], prompt user to retry
 // Return DBL_MAX as sentinel value if string cannot be read
 // Ignore finite subnormal numbers
 // Format prompt like printf(3) function for user
 double get_double(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-// Prompt user for line of characters from standard input using get_string function
+// Prompt user for input from stream like get_double function, or from standard input if stream is NULL
+double get_double_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user for line of characters from standard input without allocating
 // Return long double value. If string does not represent long double in [-LDBL_MAX, LDBL_MAX], prompt user to retry
 // Return LDBL_MAX as sentinel value if string cannot be read
 // Ignore finite subnormal numbers
 // Format prompt like printf(3) function for user
 long double get_long_double(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
+// Prompt user for input from stream like get_long_double function, or from standard input if stream is NULL
+long double get_long_double_from(stream *s, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+// Prompt user once for line of characters from stream, or from standard input if stream is NULL, without allocating
+// Parse line once like get_int function, without retrying, and store int value in value (not NULL)
+// Return INPUT_OK, or status telling why value is unchanged: INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, INPUT_RANGE, INPUT_SYNTAX,
+// or INPUT_LONG for line longer than limit of stream rejected
+// Format prompt like printf(3) function for user
+input_status try_get_int(stream *s, int *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing char value like get_char function
+input_status try_get_char(stream *s, char *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing unsigned char value like get_unsigned_char function
+input_status try_get_unsigned_char(stream *s, unsigned char *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing unsigned int value like get_unsigned_int function
+input_status try_get_unsigned_int(stream *s, unsigned int *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing long value like get_long function
+input_status try_get_long(stream *s, long *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing unsigned long value like get_unsigned_long function
+input_status try_get_unsigned_long(stream *s, unsigned long *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing long long value like get_long_long function
+input_status try_get_long_long(stream *s, long long *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing unsigned long long value like get_unsigned_long_long function
+input_status try_get_unsigned_long_long(stream *s, unsigned long long *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing float value like get_float function
+input_status try_get_float(stream *s, float *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing double value like get_double function
+input_status try_get_double(stream *s, double *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Read input once like try_get_int function, storing long double value like get_long_double function
+input_status try_get_long_double(stream *s, long double *value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Prompt user once for line of characters from stream, or from standard input if stream is NULL, like get_string function
+// Store string in value (not NULL), and return INPUT_OK, or INPUT_EOF, INPUT_TIMEOUT, INPUT_ALLOC, or INPUT_LONG leaving value unchanged
+input_status try_get_string(stream *s, char **value, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+// Prompt user once for count int values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and INT_MAX for each string that does not represent int in [INT_MIN, INT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+int *get_int_array(int *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_int_array function, or from standard input if stream is NULL
+int *get_int_array_from(stream *s, int *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count unsigned int values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and UINT_MAX for each string that does not represent unsigned int in [0, UINT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned int *get_unsigned_int_array(unsigned int *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_unsigned_int_array function, or from standard input if stream is NULL
+unsigned int *get_unsigned_int_array_from(stream *s, unsigned int *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LONG_MAX for each string that does not represent long in [LONG_MIN, LONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long *get_long_array(long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_long_array function, or from standard input if stream is NULL
+long *get_long_array_from(stream *s, long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count unsigned long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and ULONG_MAX for each string that does not represent unsigned long in [0, ULONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned long *get_unsigned_long_array(unsigned long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_unsigned_long_array function, or from standard input if stream is NULL
+unsigned long *get_unsigned_long_array_from(stream *s, unsigned long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count long long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LLONG_MAX for each string that does not represent long long in [LLONG_MIN, LLONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long long *get_long_long_array(long long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_long_long_array function, or from standard input if stream is NULL
+long long *get_long_long_array_from(stream *s, long long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count unsigned long long values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and ULLONG_MAX for each string that does not represent unsigned long long in [0, ULLONG_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+unsigned long long *get_unsigned_long_long_array(unsigned long long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_unsigned_long_long_array function, or from standard input if stream is NULL
+unsigned long long *get_unsigned_long_long_array_from(stream *s, unsigned long long *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count float values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and FLT_MAX for each string that does not represent float in [-FLT_MAX, FLT_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+float *get_float_array(float *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_float_array function, or from standard input if stream is NULL
+float *get_float_array_from(stream *s, float *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count double values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and DBL_MAX for each string that does not represent double in [-DBL_MAX, DBL_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+double *get_double_array(double *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_double_array function, or from standard input if stream is NULL
+double *get_double_array_from(stream *s, double *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Prompt user once for count long double values separated by whitespace or commas from standard input, across lines
+// Store values in array, or in arena in use if array is NULL. Discard rest of line after last value
+// Store false in valid (if not NULL) and LDBL_MAX for each string that does not represent long double in [-LDBL_MAX, LDBL_MAX] instead of retrying
+// Return array and update count to number of values read, or return NULL on errors or no input (EOF)
+// Format prompt like printf(3) function for user
+long double *get_long_double_array(long double *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 4, 5)));
+
+// Prompt user for input from stream like get_long_double_array function, or from standard input if stream is NULL
+long double *get_long_double_array_from(stream *s, long double *array, size_t *count, bool *valid, const char *format, ...) __attribute__((format(printf, 5, 6)));
+
+// Read every remaining line of stream as double without prompt, or of standard input if stream is NULL
+// Split input into chunks at line endings, parsed by threads (number of processors if threads is 0)
+// Return values in order of lines on heap, freed by caller with free(3), and store number of lines in count
+// Store DBL_MAX for each line that get_double function would reject, instead of retrying
+// Store line numbers (from 1) of rejected lines on heap in errors, freed by caller, and their number in rejected (if not NULL)
+// Apply line limit of stream, storing DBL_MAX for long line with LINE_REJECT, and keeping no value for it with LINE_DISCARD
+// Return NULL on errors or no input (EOF), with status INPUT_ALLOC or INPUT_EOF
+double *load_doubles(stream *s, size_t *count, size_t **errors, size_t *rejected, size_t threads);
+
+
+// Define opaque pump of input for event loops, reading only bytes that are ready and emitting value of each complete line
+typedef struct pump pump;
+
+// Define types of values emitted by pump
+typedef enum pump_type
+{
+    PUMP_LINE,               // Line of characters, like get_line_view function
+    PUMP_INT,                // int, like get_int function
+    PUMP_UNSIGNED_INT,       // unsigned int, like get_unsigned_int function
+    PUMP_LONG,               // long, like get_long function
+    PUMP_UNSIGNED_LONG,      // unsigned long, like get_unsigned_long function
+    PUMP_LONG_LONG,          // long long, like get_long_long function
+    PUMP_UNSIGNED_LONG_LONG, // unsigned long long, like get_unsigned_long_long function
+    PUMP_FLOAT,              // float, like get_float function
+    PUMP_DOUBLE,             // double, like get_double function
+    PUMP_LONG_DOUBLE         // long double, like get_long_double function
+} pump_type;
+
+// Define pointer type for callback of pump, called with context for each complete line
+// Point value at value of type of pump, or NULL if line does not represent value of type (always NULL for PUMP_LINE)
+// Line and value are valid only during call
+typedef void (*pump_callback)(void *context, const void *value, line_view line);
+
+// Create pump of file descriptor, emitting values of type to callback with context
+// Use -1 as file descriptor for pump fed only by pump_bytes function
+// Return NULL on errors
+// Library destructor frees pumps left on program exit
+pump *create_pump(int fd, pump_type type, pump_callback callback, void *context);
+
+// Read bytes ready on file descriptor of pump without blocking, emitting value of each complete line
+// Keep partial line and CR of CRLF pair until next call, so lines may arrive in any number of reads
+// Check readiness with poll(2) (POSIX), or read once on other platforms
+// Return number of values emitted, or -1 at end of input or errors, after emitting last line without line ending
+ptrdiff_t pump_input(pump *p);
+
+// Feed bytes to pump like pump_input function, for event loops that read input themselves
+// Pass size 0 at end of input, emitting last line without line ending
+// Return number of values emitted, or -1 on errors or after end of input
+ptrdiff_t pump_bytes(pump *p, const char *bytes, size_t size);
+
+// Set maximum number of characters of each line of pump, and policy for longer lines, like set_line_limit function
+// Discard characters beyond limit without buffering them, so hostile client cannot exhaust memory with endless line
+// Emit first limit characters with LINE_TRUNCATE, NULL value and first limit characters with LINE_REJECT, or nothing with LINE_DISCARD
+// Emit lines of any length if limit is SIZE_MAX (default)
+void set_pump_line_limit(pump *p, size_t limit, line_policy policy);
+
+// Free pump and its buffers, without closing its file descriptor
+void destroy_pump(pump *p);
+
+#if defined(__GNUC__)
+#pragma GCC visibility pop
+#endif
+
 #endif
@@ -0,0 +1,118 @@
+// Enable POSIX functions for redirecting standard input
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of values read after warm-up
+#define VALUES 100000
+
+// Count calls to allocator, wrapped at link time with -Wl,--wrap
+static size_t allocations = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+// Redirect standard input to file of lines, each value preceded by rejected retries
+// Start with long line so buffers reach steady state during warm-up
+static int redirect(const char *value)
+{
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return -1;
+
+    fprintf(file, "%*s%s\n", 200000, "", value);
+    for (size_t i = 0; i < VALUES; i++)
+        fprintf(file, "garbage\r\n  \n%s%s\r", i % 2 ? " " : "", value);
+    fprintf(file, "\n");
+
+    fflush(file);
+    rewind(file);
+    return dup2(fileno(file), STDIN_FILENO);
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <type>\n", argv[0]);
+        fprintf(stderr, "Count allocations per value read by typed functions.\n\n");
+        return 1;
+    }
+
+    const char *type = argv[1];
+    const char *value = !strcmp(type, "char") || !strcmp(type, "uchar") ? "x" : "12345";
+    if (redirect(value) < 0)
+        return 2;
+
+    size_t warm = 0, count = 0;
+    for (size_t i = 0; i <= VALUES; i++)
+    {
+        if (i == 2) // Count once first retries have grown buffers
+            warm = allocations;
+
+        bool ok;
+        if (!strcmp(type, "char"))
+            ok = get_char(NULL) == 'x';
+        else if (!strcmp(type, "uchar"))
+            ok = get_unsigned_char(NULL) == 'x';
+        else if (!strcmp(type, "int"))
+            ok = get_int(NULL) == 12345;
+        else if (!strcmp(type, "uint"))
+            ok = get_unsigned_int(NULL) == 12345;
+        else if (!strcmp(type, "long"))
+            ok = get_long(NULL) == 12345;
+        else if (!strcmp(type, "ulong"))
+            ok = get_unsigned_long(NULL) == 12345;
+        else if (!strcmp(type, "llong"))
+            ok = get_long_long(NULL) == 12345;
+        else if (!strcmp(type, "ullong"))
+            ok = get_unsigned_long_long(NULL) == 12345;
+        else if (!strcmp(type, "float"))
+            ok = get_float(NULL) == 12345;
+        else if (!strcmp(type, "double"))
+            ok = get_double(NULL) == 12345;
+        else if (!strcmp(type, "ldouble"))
+            ok = get_long_double(NULL) == 12345;
+        else
+        {
+            fprintf(stderr, "\nError: Unknown type '%s'\n\n", type);
+            return 1;
+        }
+
+        if (!ok)
+        {
+            fprintf(stderr, "%s: wrong value %zu\n", type, i);
+            return 3;
+        }
+        count++;
+    }
+
+    size_t extra = allocations - warm;
+    printf("%-8s %zu values, %zu allocations after warm-up\n", type, count - 2, extra);
+    return extra == 0 ? 0 : 4;
+}
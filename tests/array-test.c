@@ -0,0 +1,247 @@
+// Enable POSIX functions for redirecting standard input
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of calls, maximum number of values in each call, and maximum number of values on each line
+#define CALLS 20000
+#define VALUES 40
+#define PER_LINE 6
+
+// Initialise tokens expected by each call, in order
+static char *tokens[CALLS][VALUES];
+static size_t counts[CALLS];
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Return random token of numeric syntax, valid or not
+static char *token(unsigned long *state)
+{
+    static const char *edges[] = {
+        "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "-0", "+7",
+        "18446744073709551615", "18446744073709551616", "1e400", "1e-400", "0x1p3", "inf", "nan",
+        "x", "1.5.5", "--1", "3e", ".e1", ".5", "5.", "1e-310", "340282346638528859811704183484516925440",
+    };
+
+    char text[64];
+    unsigned long kind = next(state) % 4;
+    if (kind == 0)
+        return strdup(edges[next(state) % (sizeof(edges) / sizeof(edges[0]))]);
+
+    size_t size = 0;
+    if (next(state) % 3 == 0)
+        text[size++] = "+-"[next(state) % 2];
+    for (size_t i = 1 + next(state) % 20; i > 0; i--)
+        text[size++] = '0' + next(state) % 10;
+    if (kind == 2)
+    {
+        text[size++] = '.';
+        for (size_t i = next(state) % 8; i > 0; i--)
+            text[size++] = '0' + next(state) % 10;
+    }
+    if (kind == 3)
+        size += sprintf(text + size, "e%d", (int)(next(state) % 80) - 40);
+    text[size] = '\0';
+    return strdup(text);
+}
+
+// Write tokens of each call to file on standard input, with random separators, empty lines, and line endings
+// Follow last token of each call with extra tokens on its line, which the library discards
+static bool generate(unsigned long seed)
+{
+    static const char *separators[] = {" ", ",", "\t", " , ", ",,", "  \v", "\f"};
+    static const char *endings[] = {"\n", "\r", "\r\n"};
+
+    unsigned long state = seed;
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < CALLS; i++)
+    {
+        counts[i] = next(&state) % (VALUES + 1);
+        size_t column = 0;
+        for (size_t j = 0; j < counts[i]; j++)
+        {
+            tokens[i][j] = token(&state);
+            if (tokens[i][j] == NULL)
+                return false;
+
+            if (next(&state) % 4 == 0)
+                fputs(separators[next(&state) % (sizeof(separators) / sizeof(separators[0]))], file);
+            fputs(tokens[i][j], file);
+            fputs(separators[next(&state) % (sizeof(separators) / sizeof(separators[0]))], file);
+
+            if (++column == PER_LINE && j + 1 < counts[i]) // Break line between tokens of call
+            {
+                fputs(endings[next(&state) % 3], file);
+                if (next(&state) % 8 == 0)
+                    fputs(endings[next(&state) % 3], file);
+                column = 0;
+            }
+        }
+
+        if (next(&state) % 2 && counts[i] > 0)
+            fputs("999 junk", file);
+        if (counts[i] > 0)
+            fputs(endings[next(&state) % 3], file);
+    }
+
+    fflush(file);
+    rewind(file);
+    return dup2(fileno(file), STDIN_FILENO) >= 0;
+}
+
+// Convert token like get_int function with strtol(3), storing INT_MAX if token is rejected
+// Return false if token is rejected
+static bool int_reference(const char *str, int *value)
+{
+    errno = 0;
+    char *end;
+    long val = strtol(str, &end, 10);
+    bool ok = *str != '\0' && errno == 0 && *end == '\0' && val >= INT_MIN && val <= INT_MAX;
+    *value = ok ? (int)val : INT_MAX;
+    return ok;
+}
+
+// Convert token like get_unsigned_long_long function with strtoull(3), storing ULLONG_MAX if token is rejected
+// Return false if token is rejected
+static bool ullong_reference(const char *str, unsigned long long *value)
+{
+    errno = 0;
+    char *end;
+    unsigned long long val = strtoull(str, &end, 10);
+    bool ok = *str != '\0' && *str != '-' && errno == 0 && *end == '\0';
+    *value = ok ? val : ULLONG_MAX;
+    return ok;
+}
+
+// Convert token like get_double function with strtod(3), storing DBL_MAX if token is rejected
+// Return false if token is rejected
+static bool double_reference(const char *str, double *value)
+{
+    errno = 0;
+    char *end;
+    double val = strtod(str, &end);
+    bool ok = *str != '\0' && errno == 0 && *end == '\0' && isfinite(val);
+    *value = ok ? val : DBL_MAX;
+    return ok;
+}
+
+// Report first element of call that differs from reference
+static bool mismatch(const char *type, size_t i, size_t j, bool valid, bool expected)
+{
+    if (valid == expected)
+        return false;
+    fprintf(stderr, "%s: call %zu value %zu \"%s\": got valid %d, expected %d\n", type, i, j, tokens[i][j], valid, expected);
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "\nUsage: %s <int | ullong | double> <seed>\n", argv[0]);
+        fprintf(stderr, "Compare array functions against strtol(3) family on random tokens.\n\n");
+        return 1;
+    }
+
+    const char *type = argv[1];
+    if (!generate(strtoul(argv[2], NULL, 10)))
+        return 2;
+
+    // Read calls into caller arrays, and every fourth call into arena
+    arena *a = create_arena();
+    if (a == NULL)
+        return 2;
+
+    size_t values = 0;
+    for (size_t i = 0; i < CALLS; i++)
+    {
+        if (counts[i] == 0)
+            continue;
+
+        bool in_arena = i % 4 == 0;
+        use_arena(in_arena ? a : NULL);
+
+        bool valid[VALUES];
+        size_t count = counts[i];
+        bool failed = false;
+        if (!strcmp(type, "int"))
+        {
+            static int array[VALUES];
+            int *got = get_int_array(in_arena ? NULL : array, &count, valid, NULL), expected;
+            failed = got == NULL;
+            for (size_t j = 0; j < count && !failed; j++)
+                failed = mismatch(type, i, j, valid[j], int_reference(tokens[i][j], &expected)) || got[j] != expected;
+        }
+        else if (!strcmp(type, "ullong"))
+        {
+            static unsigned long long array[VALUES];
+            unsigned long long *got = get_unsigned_long_long_array(in_arena ? NULL : array, &count, valid, NULL), expected;
+            failed = got == NULL;
+            for (size_t j = 0; j < count && !failed; j++)
+                failed = mismatch(type, i, j, valid[j], ullong_reference(tokens[i][j], &expected)) || got[j] != expected;
+        }
+        else if (!strcmp(type, "double"))
+        {
+            static double array[VALUES];
+            double *got = get_double_array(in_arena ? NULL : array, &count, valid, NULL), expected;
+            failed = got == NULL || (in_arena && (uintptr_t)got % _Alignof(max_align_t) != 0); // Check alignment in arena
+            for (size_t j = 0; j < count && !failed; j++)
+                failed = mismatch(type, i, j, valid[j], double_reference(tokens[i][j], &expected)) || memcmp(&got[j], &expected, sizeof(double));
+        }
+        else
+        {
+            fprintf(stderr, "\nError: Unknown type '%s'\n\n", type);
+            return 1;
+        }
+
+        if (failed)
+        {
+            fprintf(stderr, "%s: call %zu: values differ from reference\n", type, i);
+            return 3;
+        }
+
+        if (count != counts[i])
+        {
+            fprintf(stderr, "%s: call %zu: got %zu values, expected %zu\n", type, i, count, counts[i]);
+            return 3;
+        }
+        values += count;
+
+        if (in_arena)
+            reset_arena(a);
+    }
+
+    // Check short read at EOF
+    size_t count = 3;
+    bool valid[3] = {true, true, true};
+    int array[3];
+    if (get_int_array(array, &count, valid, NULL) != NULL || count != 0 || valid[2] || array[2] != INT_MAX)
+    {
+        fprintf(stderr, "%s: expected no values at EOF\n", type);
+        return 3;
+    }
+
+    destroy_arena(a);
+    printf("%-8s %d calls, %zu values, matching strtol(3) family\n", type, CALLS, values);
+    return 0;
+}
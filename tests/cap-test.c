@@ -0,0 +1,362 @@
+// Enable POSIX functions for pipes and resource limits
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of lines, limit of line length, and length of line too long to buffer
+#define LINES 20000
+#define LIMIT 100
+#define HUGE_LINE (1UL << 30)
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                  \
+    if (!(condition))                                                     \
+    {                                                                     \
+        fprintf(stderr, "cap-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                         \
+    }
+
+// Initialise generated text, and start and length of each line in it
+static char *text;
+static size_t size;
+static size_t starts[LINES], lengths[LINES];
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Generate lines around limit, some far longer than block, with random line endings and last line without line ending
+static bool generate(unsigned long seed)
+{
+    static const char *endings[] = {"\n", "\r", "\r\n"};
+
+    unsigned long state = seed;
+    FILE *file = open_memstream(&text, &size);
+    if (file == NULL)
+        return false;
+
+    const char *ending = "";
+    for (size_t i = 0; i < LINES; i++)
+    {
+        size_t length = next(&state) % 64 == 0 ? next(&state) % 200000 : next(&state) % (2 * LIMIT + 2);
+        if (length == 0 && !strcmp(ending, "\r")) // Keep empty line after CR apart from CRLF
+            length = 1;
+        starts[i] = ftell(file);
+        lengths[i] = length;
+        for (size_t j = 0; j < length; j++)
+            fputc('a' + (i + j) % 26, file);
+        ending = endings[next(&state) % 3];
+        if (i + 1 < LINES)
+            fputs(ending, file);
+    }
+    return fclose(file) == 0;
+}
+
+// Return text in pieces of random size, as callback of stream
+static ptrdiff_t pieces(void *context, char *buffer, size_t capacity)
+{
+    size_t *offset = context;
+    size_t n = 1 + *offset * 2654435761u % 300;
+    if (n > capacity)
+        n = capacity;
+    if (n > size - *offset)
+        n = size - *offset;
+    memcpy(buffer, text + *offset, n);
+    *offset += n;
+    return (ptrdiff_t)n;
+}
+
+// Read every line with policy through reader of kind, and compare lines and statuses against generated lines
+static bool compare(const char *kind, stream *s, line_policy policy)
+{
+    set_line_limit(s, LIMIT, policy);
+    for (size_t i = 0; i <= LINES; i++)
+    {
+        // Skip lines dropped by policy, and expect failed call for rejected line
+        while (i < LINES && lengths[i] > LIMIT && policy == LINE_DISCARD)
+            i++;
+        size_t length = i < LINES ? (lengths[i] < LIMIT ? lengths[i] : LIMIT) : 0;
+        input_status wanted = i == LINES ? INPUT_EOF : lengths[i] > LIMIT && policy == LINE_REJECT ? INPUT_LONG : INPUT_OK;
+
+        line_view got = {NULL, 0};
+        if (!strcmp(kind, "view"))
+            got = get_line_view_from(s, NULL);
+        else if ((got.data = get_string_from(s, NULL)) != NULL)
+            got.size = strlen(got.data);
+
+        bool same = get_status() == wanted && (got.data != NULL) == (wanted == INPUT_OK);
+        same = same && (got.data == NULL || (got.size == length && !memcmp(got.data, text + starts[i], length)));
+        if (!same)
+        {
+            fprintf(stderr, "cap-test: %s, policy %d: line %zu: got %zu characters, status %d, expected %zu, status %d\n",
+                    kind, policy, i + 1, got.size, get_status(), length, wanted);
+            return false;
+        }
+        if (got.data != NULL && !strcmp(kind, "string"))
+            free_string((char *)got.data);
+    }
+    return true;
+}
+
+// Define line checked against pieces passed by get_line_chunks function
+typedef struct gathered
+{
+    size_t line;   // Index of line
+    size_t offset; // Number of bytes of line passed
+    size_t size;   // Size of pieces
+    bool failed;   // Indicate piece differs from line, or has wrong size
+} gathered;
+
+// Check piece passed by get_line_chunks function against generated line
+static void gather(void *context, const char *data, size_t piece, bool last)
+{
+    gathered *g = context;
+    size_t i = g->line;
+    bool same = last ? piece <= g->size && g->offset + piece == lengths[i] : piece == g->size && g->offset + piece < lengths[i];
+    if (!same || memcmp(data, text + starts[i] + g->offset, piece))
+        g->failed = true;
+    g->offset += piece;
+}
+
+// Return generated line of 'x' characters without line ending in pieces, as callback of stream
+static ptrdiff_t endless(void *context, char *buffer, size_t capacity)
+{
+    size_t *left = context;
+    size_t n = capacity < *left ? capacity : *left;
+    memset(buffer, 'x', n);
+    *left -= n;
+    return (ptrdiff_t)n;
+}
+
+// Return "1.5", line of HUGE_LINE '1' characters, and "2.5" in pieces, as callback of stream
+static ptrdiff_t numbers(void *context, char *buffer, size_t capacity)
+{
+    size_t *offset = context, n = 0;
+    while (n < capacity && *offset < HUGE_LINE + 8)
+    {
+        size_t run = HUGE_LINE + 4 - *offset;
+        if (*offset < 4 || *offset >= HUGE_LINE + 4)
+        {
+            buffer[n++] = *offset < 4 ? "1.5\n"[*offset] : "\n2.5"[*offset - HUGE_LINE - 4];
+            run = 1;
+        }
+        else
+        {
+            if (run > capacity - n)
+                run = capacity - n;
+            memset(buffer + n, '1', run);
+            n += run;
+        }
+        *offset += run;
+    }
+    return (ptrdiff_t)n;
+}
+
+// Check values and rejected lines loaded with policy against "1.5", long line of '1' characters, and "2.5"
+static bool loaded(stream *s, size_t limit, line_policy policy)
+{
+    set_line_limit(s, limit, policy);
+    size_t count = 0, *errors = NULL, rejected = 0;
+    double *values = load_doubles(s, &count, &errors, &rejected, 1), truncated = 0;
+    for (size_t i = 0; i < limit; i++)
+        truncated = truncated * 10 + 1;
+
+    bool same = values != NULL && get_status() == INPUT_OK && values[0] == 1.5 && values[count - 1] == 2.5;
+    if (policy == LINE_DISCARD)
+        same = same && count == 2 && rejected == 0;
+    else if (policy == LINE_REJECT)
+        same = same && count == 3 && values[1] == DBL_MAX && rejected == 1 && errors[0] == 2;
+    else
+        same = same && count == 3 && values[1] == truncated && rejected == 0;
+    if (!same)
+        fprintf(stderr, "cap-test: load_doubles, policy %d: got %zu values, %zu rejected, status %d\n", policy, count, rejected, get_status());
+    free(values);
+    free(errors);
+    return same;
+}
+
+// Define lines emitted by pump
+typedef struct emitted
+{
+    size_t lines;    // Number of lines
+    size_t size;     // Size of last line
+    bool valid;      // Indicate last line had value
+    int value;       // Value of last line with value
+    char first[8];   // Start of last line
+} emitted;
+
+// Record line emitted by pump
+static void record(void *context, const void *value, line_view line)
+{
+    emitted *e = context;
+    e->lines++;
+    e->size = line.size;
+    e->valid = value != NULL;
+    if (value != NULL)
+        e->value = *(const int *)value;
+    snprintf(e->first, sizeof(e->first), "%.*s", (int)(line.size < 7 ? line.size : 7), line.data);
+}
+
+// Append piece passed by get_line_chunks function to buffer, followed by '$' for last piece or '|' otherwise
+static void append(void *context, const char *data, size_t piece, bool last)
+{
+    strncat(context, data, piece);
+    strcat(context, last ? "$" : "|");
+}
+
+// Count bytes passed by get_line_chunks function
+static void count(void *context, const char *data, size_t piece, bool last)
+{
+    *(size_t *)context += piece;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <seed>\n", argv[0]);
+        fprintf(stderr, "Check line limits and policies, pieces of get_line_chunks function, load_doubles function, and pumps.\n\n");
+        return 1;
+    }
+
+    if (!generate(strtoul(argv[1], NULL, 10)))
+        return 2;
+
+    // Compare every policy on memory and on callback returning pieces, so long lines straddle blocks
+    static const char *kinds[] = {"string", "arena", "view"};
+    arena *a = create_arena();
+    CHECK(a != NULL);
+    for (size_t k = 0; k < 3; k++)
+        for (line_policy policy = LINE_TRUNCATE; policy <= LINE_DISCARD; policy++)
+        {
+            use_arena(!strcmp(kinds[k], "arena") ? a : NULL);
+            size_t offset = 0;
+            stream *m = create_memory_stream(text, size), *c = create_callback_stream(pieces, &offset);
+            CHECK(m != NULL && c != NULL);
+            CHECK(compare(kinds[k], m, policy) && compare(kinds[k], c, policy));
+            destroy_stream(m);
+            destroy_stream(c);
+            reset_arena(a);
+        }
+    use_arena(NULL);
+    destroy_arena(a);
+
+    // Pass every line in pieces of several sizes, ignoring line limit
+    for (size_t piece = 1; piece <= 4096; piece *= 8)
+    {
+        size_t offset = 0;
+        stream *c = create_callback_stream(pieces, &offset);
+        CHECK(c != NULL);
+        set_line_limit(c, LIMIT, LINE_REJECT);
+        gathered g = {0, 0, piece, false};
+        for (; g.line < LINES; g.line++, g.offset = 0)
+            CHECK(get_line_chunks(c, piece, gather, &g, NULL) == INPUT_OK && !g.failed && g.offset == lengths[g.line]);
+        CHECK(get_line_chunks(c, piece, gather, &g, NULL) == INPUT_EOF);
+        destroy_stream(c);
+    }
+
+    // Reject typed input of long line with sentinel value, then read next line
+    stream *s = create_memory_stream("1234567\n42\n", 11);
+    CHECK(s != NULL);
+    set_line_limit(s, 4, LINE_REJECT);
+    CHECK(get_int_from(s, NULL) == INT_MAX && get_status() == INPUT_LONG);
+    CHECK(get_int_from(s, NULL) == 42 && get_status() == INPUT_OK);
+    destroy_stream(s);
+
+    // Read line longer than address space allows, truncated and in pieces, without buffering it
+    struct rlimit space = {256UL << 20, 256UL << 20};
+    CHECK(setrlimit(RLIMIT_AS, &space) == 0);
+    size_t left = HUGE_LINE;
+    s = create_callback_stream(endless, &left);
+    CHECK(s != NULL);
+    set_line_limit(s, 4096, LINE_TRUNCATE);
+    char *str = get_string_from(s, NULL);
+    CHECK(str != NULL && strlen(str) == 4096 && left == 0);
+    destroy_stream(s);
+    left = HUGE_LINE;
+    s = create_callback_stream(endless, &left);
+    CHECK(s != NULL);
+    size_t total = 0;
+    CHECK(get_line_chunks(s, 65536, count, &total, NULL) == INPUT_OK && total == HUGE_LINE);
+    destroy_stream(s);
+
+    // Load long line as truncated value, sentinel value, or nothing, from memory and from callback without buffering line
+    for (line_policy policy = LINE_TRUNCATE; policy <= LINE_DISCARD; policy++)
+    {
+        s = create_memory_stream("1.5\r\n1111111111\r\n2.5", 21);
+        CHECK(s != NULL && loaded(s, 8, policy));
+        destroy_stream(s);
+        size_t offset = 0;
+        s = create_callback_stream(numbers, &offset);
+        CHECK(s != NULL && loaded(s, 8, policy) && offset == HUGE_LINE + 8);
+        destroy_stream(s);
+    }
+
+    // Emit long line of pump as truncated value, rejected value, or nothing, and feed endless line without buffering it
+    static char piece[65536];
+    memset(piece, 'x', sizeof(piece));
+    for (line_policy policy = LINE_TRUNCATE; policy <= LINE_DISCARD; policy++)
+    {
+        emitted e = {0};
+        pump *p = create_pump(-1, PUMP_INT, record, &e);
+        CHECK(p != NULL);
+        set_pump_line_limit(p, 4, policy);
+        CHECK(pump_bytes(p, "123", 3) == 0 && pump_bytes(p, "4567\n42\n", 8) == (policy == LINE_DISCARD ? 1 : 2));
+        CHECK(e.lines == (policy == LINE_DISCARD ? 1 : 2) && e.valid && e.value == 42);
+        CHECK(pump_bytes(p, "98765", 5) == 0 && pump_bytes(p, "", 0) == (policy == LINE_DISCARD ? 0 : 1));
+        if (policy != LINE_DISCARD)
+            CHECK(e.size == 4 && !strcmp(e.first, "9876") && e.valid == (policy == LINE_TRUNCATE) && (!e.valid || e.value == 9876));
+        destroy_pump(p);
+
+        e = (emitted){0};
+        p = create_pump(-1, PUMP_LINE, record, &e);
+        CHECK(p != NULL);
+        set_pump_line_limit(p, LIMIT, policy);
+        for (size_t fed = 0; fed < HUGE_LINE; fed += sizeof(piece))
+            CHECK(pump_bytes(p, piece, sizeof(piece)) == 0);
+        CHECK(pump_bytes(p, "\nyz\n", 4) == (policy == LINE_DISCARD ? 1 : 2));
+        CHECK(e.lines == (policy == LINE_DISCARD ? 1 : 2) && e.size == 2 && !strcmp(e.first, "yz"));
+        destroy_pump(p);
+    }
+
+    // Keep truncated line across timeout, then discard rest of line written later
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    s = create_fd_stream(fds[0]);
+    CHECK(s != NULL);
+    set_limits(s, 10, SIZE_MAX);
+    set_line_limit(s, 4, LINE_TRUNCATE);
+    CHECK(write(fds[1], "abcdefg", 7) == 7);
+    CHECK(get_string_from(s, NULL) == NULL && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "hij\nklm\n", 8) == 8);
+    str = get_string_from(s, NULL);
+    CHECK(str != NULL && !strcmp(str, "abcd"));
+    str = get_string_from(s, NULL);
+    CHECK(str != NULL && !strcmp(str, "klm"));
+
+    // Pass full pieces before timeout, and keep rest for next call
+    char buffer[64] = "";
+    CHECK(write(fds[1], "abcdefg", 7) == 7);
+    CHECK(get_line_chunks(s, 3, append, buffer, NULL) == INPUT_TIMEOUT && !strcmp(buffer, "abc|def|"));
+    CHECK(write(fds[1], "hi\n", 3) == 3);
+    CHECK(get_line_chunks(s, 3, append, buffer, NULL) == INPUT_OK && !strcmp(buffer, "abc|def|ghi$"));
+    destroy_stream(s);
+    close(fds[0]);
+    close(fds[1]);
+
+    free(text);
+    fprintf(stderr, "cap-test: %d lines, limit %d, matching every policy and piece size\n", LINES, LIMIT);
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Include library source first to reach internal parsers, which enables GNU-specific attributes
+#include "../src/stdprompt.c"
+
+// Define number of random double and long double values
+#define VALUES 300000
+
+// Return pseudo-random number from linear congruential generator
+static uint64_t next(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29);
+}
+
+// Convert string like previous get_* functions with strtof(3) family
+// Return false if string is rejected
+static bool reference_float(const char *str, float *value)
+{
+    while (isspace((unsigned char)*str))
+        str++;
+    if (*str == '\0')
+        return false;
+
+    errno = 0;
+    char *end;
+    *value = strtof(str, &end);
+    while (isspace((unsigned char)*end))
+        end++;
+    return errno == 0 && *end == '\0' && isfinite(*value) && *value >= -FLT_MAX && *value <= FLT_MAX;
+}
+
+static bool reference_double(const char *str, double *value)
+{
+    while (isspace((unsigned char)*str))
+        str++;
+    if (*str == '\0')
+        return false;
+
+    errno = 0;
+    char *end;
+    *value = strtod(str, &end);
+    while (isspace((unsigned char)*end))
+        end++;
+    return errno == 0 && *end == '\0' && isfinite(*value) && *value >= -DBL_MAX && *value <= DBL_MAX;
+}
+
+static bool reference_long_double(const char *str, long double *value)
+{
+    while (isspace((unsigned char)*str))
+        str++;
+    if (*str == '\0')
+        return false;
+
+    errno = 0;
+    char *end;
+    *value = strtold(str, &end);
+    while (isspace((unsigned char)*end))
+        end++;
+    return errno == 0 && *end == '\0' && isfinite(*value) && *value >= -LDBL_MAX && *value <= LDBL_MAX;
+}
+
+// Compare parser against reference on string, requiring same acceptance and same bits
+static bool check_float(const char *str)
+{
+    float got, expected;
+    bool ok = parse_float(&input, str, strlen(str), &got) == INPUT_OK;
+    if (ok != reference_float(str, &expected) || (ok && memcmp(&got, &expected, sizeof(float)) != 0))
+    {
+        fprintf(stderr, "float: \"%s\" got %d %.9g, expected %.9g\n", str, ok, got, expected);
+        return false;
+    }
+    return true;
+}
+
+static bool check_double(const char *str)
+{
+    double got, expected;
+    bool ok = parse_double(&input, str, strlen(str), &got) == INPUT_OK;
+    if (ok != reference_double(str, &expected) || (ok && memcmp(&got, &expected, sizeof(double)) != 0))
+    {
+        fprintf(stderr, "double: \"%s\" got %d %.17g, expected %.17g\n", str, ok, got, expected);
+        return false;
+    }
+    return true;
+}
+
+static bool check_long_double(const char *str)
+{
+    long double got, expected;
+    bool ok = parse_long_double(&input, str, strlen(str), &got) == INPUT_OK;
+    if (ok != reference_long_double(str, &expected) || (ok && (got != expected || signbit(got) != signbit(expected))))
+    {
+        fprintf(stderr, "long double: \"%s\" got %d %.21Lg, expected %.21Lg\n", str, ok, got, expected);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <stride>\n", argv[0]);
+        fprintf(stderr, "Round-trip every stride-th float bit pattern, and compare random values against strtod(3) family.\n");
+        fprintf(stderr, "Run with stride 1 for exhaustive float test.\n\n");
+        return 1;
+    }
+
+    uint64_t stride = strtoull(argv[1], NULL, 10);
+    if (stride == 0)
+        return 1;
+
+    // Round-trip float bit patterns through 9 significant digits, and compare 6 digits against strtof(3)
+    char str[64];
+    uint64_t floats = 0;
+    for (uint64_t bits = 0; bits <= UINT32_MAX; bits += stride)
+    {
+        uint32_t word = (uint32_t)bits;
+        float f;
+        memcpy(&f, &word, sizeof(f));
+        if (!isfinite(f) || (f != 0 && !isnormal(f)))
+            continue;
+
+        float got;
+        snprintf(str, sizeof(str), "%.9g", f);
+        if (parse_float(&input, str, strlen(str), &got) != INPUT_OK || memcmp(&got, &f, sizeof(f)) != 0)
+        {
+            fprintf(stderr, "float: \"%s\" does not round-trip to %08x\n", str, (unsigned)word);
+            return 2;
+        }
+
+        snprintf(str, sizeof(str), "%.6g", f);
+        if (!check_float(str))
+            return 2;
+        floats++;
+    }
+
+    // Compare random values with random precision and notation against strtod(3) and strtold(3)
+    static const char *shapes[] = {"%.*g", "%.*e", "%.*f"};
+    uint64_t state = 1;
+    for (int i = 0; i < VALUES; i++)
+    {
+        uint64_t bits = next(&state);
+        int precision = next(&state) % 20;
+        const char *shape = shapes[next(&state) % 3];
+
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (!isfinite(d))
+            continue;
+        if (next(&state) % 2) // Keep half of values in range of fast path
+            d = ldexp(fmod(d, 1.0), (int)(next(&state) % 80) - 40);
+
+        snprintf(str, sizeof(str), shape, precision, d);
+        if (!check_double(str) || !check_float(str))
+            return 3;
+
+        // Compare integers beyond 2^53 with odd last digits, halfway between doubles when shifted, against strtod(3)
+        uint64_t integer = (next(&state) >> 10 | 1ULL << 53 | 1) << next(&state) % 11;
+        snprintf(str, sizeof(str), "%llu", (unsigned long long)integer);
+        if (!check_double(str))
+            return 3;
+
+        long double ld = (long double)d * (1 + 1.0L / (next(&state) % 1000 + 3));
+        snprintf(str, sizeof(str), "%.*Lg", precision, ld);
+        if (!check_long_double(str))
+            return 3;
+    }
+
+    printf("float-test: %llu floats round-trip, %d random values match strtod(3) family\n", (unsigned long long)floats, VALUES);
+    return 0;
+}
@@ -0,0 +1,205 @@
+// Enable POSIX functions for redirecting standard input
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of random lines and value of marker line after each of them
+#define LINES 200000
+#define MARKER 7
+
+// Initialise random lines, which may contain '\0'
+static char *lines[LINES];
+static size_t sizes[LINES];
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Append random piece of integer syntax to line
+static size_t piece(char *line, size_t size, unsigned long *state)
+{
+    static const char *edges[] = {
+        "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+        "18446744073709551615", "18446744073709551616", "99999999999999999999", "000000000000000000000000001",
+    };
+    static const char *parts[] = {" ", "\t", "\v", "\f", "+", "-", "0", "x", ".", "e", "\0", "\x85"};
+
+    unsigned long kind = next(state) % 10;
+    const char *text;
+    char digits[32];
+
+    if (kind < 2)
+        text = edges[next(state) % (sizeof(edges) / sizeof(edges[0]))];
+    else if (kind < 6)
+    {
+        size_t n = next(state) % 24;
+        for (size_t i = 0; i < n; i++)
+            digits[i] = '0' + next(state) % 10;
+        digits[n] = '\0';
+        text = digits;
+    }
+    else
+    {
+        text = parts[next(state) % (sizeof(parts) / sizeof(parts[0]))];
+        if (*text == '\0')
+        {
+            line[size] = '\0';
+            return size + 1;
+        }
+    }
+
+    memcpy(line + size, text, strlen(text));
+    return size + strlen(text);
+}
+
+// Generate random lines and write them to file on standard input, each followed by marker line
+static bool generate(unsigned long seed)
+{
+    unsigned long state = seed;
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        char line[256];
+        size_t size = 0, count = 1 + next(&state) % 4;
+        for (size_t j = 0; j < count; j++)
+            size = piece(line, size, &state);
+
+        lines[i] = malloc(size + 1);
+        if (lines[i] == NULL)
+            return false;
+        memcpy(lines[i], line, size);
+        lines[i][size] = '\0';
+        sizes[i] = size;
+
+        fwrite(line, 1, size, file);
+        fprintf(file, "\n%d\n", MARKER);
+    }
+
+    fflush(file);
+    rewind(file);
+    return dup2(fileno(file), STDIN_FILENO) >= 0;
+}
+
+// Convert line like previous get_* functions with strtol(3) and strtoul(3) families
+// Return false if line is rejected
+static bool reference(const char *line, bool sign, bool wide, long long min, unsigned long long max, unsigned long long *value)
+{
+    const char *str = line;
+    while (isspace((unsigned char)*str)) // Trim leading whitespace
+        str++;
+
+    if (*str == '\0') // Check for empty string
+        return false;
+
+    if (!sign && *str == '-') // Reject negative value
+        return false;
+
+    errno = 0;
+    char *end;
+    long long signed_val = 0;
+    unsigned long long unsigned_val = 0;
+    if (sign)
+        signed_val = wide ? strtoll(str, &end, 10) : strtol(str, &end, 10);
+    else
+        unsigned_val = wide ? strtoull(str, &end, 10) : strtoul(str, &end, 10);
+
+    while (isspace((unsigned char)*end)) // Trim trailing whitespace
+        end++;
+
+    if (errno != 0 || *end != '\0')
+        return false;
+
+    if (sign)
+    {
+        if (signed_val < min || (signed_val > 0 && (unsigned long long)signed_val > max))
+            return false;
+        *value = (unsigned long long)signed_val;
+    }
+    else
+    {
+        if (unsigned_val > max)
+            return false;
+        *value = unsigned_val;
+    }
+    return true;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "\nUsage: %s <type> <seed>\n", argv[0]);
+        fprintf(stderr, "Compare typed functions against strtol(3) family on random lines.\n\n");
+        return 1;
+    }
+
+    const char *type = argv[1];
+    if (!generate(strtoul(argv[2], NULL, 10)))
+        return 2;
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < LINES; i++)
+    {
+        // Read value from library, which skips rejected line and then returns marker
+        unsigned long long got, expected;
+        bool sign = true, wide = false;
+        long long min = 0;
+        unsigned long long max = 0;
+
+        if (!strcmp(type, "int"))
+            got = (unsigned long long)(long long)get_int(NULL), min = INT_MIN, max = INT_MAX;
+        else if (!strcmp(type, "uint"))
+            got = get_unsigned_int(NULL), sign = false, max = UINT_MAX;
+        else if (!strcmp(type, "long"))
+            got = (unsigned long long)(long long)get_long(NULL), min = LONG_MIN, max = LONG_MAX;
+        else if (!strcmp(type, "ulong"))
+            got = get_unsigned_long(NULL), sign = false, max = ULONG_MAX;
+        else if (!strcmp(type, "llong"))
+            got = (unsigned long long)get_long_long(NULL), wide = true, min = LLONG_MIN, max = LLONG_MAX;
+        else if (!strcmp(type, "ullong"))
+            got = get_unsigned_long_long(NULL), sign = false, wide = true, max = ULLONG_MAX;
+        else
+        {
+            fprintf(stderr, "\nError: Unknown type '%s'\n\n", type);
+            return 1;
+        }
+
+        if (!reference(lines[i], sign, wide, min, max, &expected))
+            expected = MARKER;
+        else
+        {
+            accepted++;
+            if (got == expected) // Consume marker line after accepted line
+            {
+                unsigned long long marker = sign ? (unsigned long long)get_long_long(NULL) : get_unsigned_long_long(NULL);
+                if (marker != MARKER)
+                    got = marker;
+            }
+        }
+
+        if (got != expected)
+        {
+            fprintf(stderr, "%s: line %zu \"%s\" (%zu bytes): got %llu, expected %llu\n", type, i, lines[i], sizes[i], got, expected);
+            return 3;
+        }
+    }
+
+    printf("%-8s %d lines, %zu accepted, matching strtol(3) family\n", type, LINES, accepted);
+    return 0;
+}
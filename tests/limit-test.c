@@ -0,0 +1,115 @@
+// Enable POSIX functions for pipes, redirecting standard input, and clocks
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "../src/stdprompt.h"
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                    \
+    if (!(condition))                                                       \
+    {                                                                       \
+        fprintf(stderr, "limit-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                           \
+    }
+
+// Return monotonic time in milliseconds
+static long long now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Write byte into pipe every 20 milliseconds without line ending, like stuck producer
+static void *drip(void *argument)
+{
+    int fd = *(int *)argument;
+    struct timespec pause = {0, 20000000};
+    for (size_t i = 0; i < 15; i++)
+    {
+        if (write(fd, "7", 1) != 1)
+            break;
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    stream *s = create_fd_stream(fds[0]);
+    CHECK(s != NULL);
+
+    // Time out with nothing written, then with partial line kept for next call of each kind
+    set_limits(s, 10, SIZE_MAX);
+    CHECK(get_int_from(s, NULL) == INT_MAX && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "12", 2) == 2);
+    CHECK(get_int_from(s, NULL) == INT_MAX && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "3", 1) == 1);
+    CHECK(get_string_from(s, NULL) == NULL && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "4", 1) == 1);
+    arena *a = create_arena();
+    CHECK(a != NULL);
+    use_arena(a);
+    CHECK(get_string_from(s, NULL) == NULL && get_status() == INPUT_TIMEOUT);
+    use_arena(NULL);
+    CHECK(write(fds[1], "5", 1) == 1);
+    CHECK(get_line_view_from(s, NULL).data == NULL && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "6\r", 2) == 2);
+    CHECK(get_int_from(s, NULL) == 123456 && get_status() == INPUT_OK);
+
+    // Skip LF of CRLF pair split by timeout, then read late line
+    CHECK(get_line_view_from(s, NULL).data == NULL && get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "\nlate\n", 6) == 6);
+    char *str = get_string_from(s, NULL);
+    CHECK(str != NULL && !strcmp(str, "late") && get_status() == INPUT_OK);
+
+    // Time out whole call, not each read, while producer writes byte at a time
+    pthread_t id;
+    CHECK(pthread_create(&id, NULL, drip, &fds[1]) == 0);
+    set_limits(s, 100, SIZE_MAX);
+    long long start = now();
+    CHECK(get_long_from(s, NULL) == LONG_MAX && get_status() == INPUT_TIMEOUT);
+    long long elapsed = now() - start;
+    CHECK(elapsed >= 90 && elapsed < 250);
+    pthread_join(id, NULL);
+    set_limits(s, -1, SIZE_MAX); // Keep status of last read across configuration
+    CHECK(get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "\n", 1) == 1);
+    CHECK(get_long_from(s, NULL) == 777777777777777L && get_status() == INPUT_OK);
+
+    // Give up after retries allowed, then read next line, and report EOF
+    static const char lines[] = "x\ny\nz\n5\n1\n2\n3\n";
+    stream *m = create_memory_stream(lines, sizeof(lines) - 1);
+    CHECK(m != NULL);
+    set_limits(m, -1, 2);
+    CHECK(get_double_from(m, NULL) == DBL_MAX && get_status() == INPUT_EXHAUSTED);
+    CHECK(get_double_from(m, NULL) == 5 && get_status() == INPUT_OK);
+    set_limits(m, -1, 0);
+    int values[4];
+    size_t count = 4;
+    CHECK(get_int_array_from(m, values, &count, NULL, NULL) == values && count == 3 && get_status() == INPUT_EOF);
+    CHECK(get_int_from(m, NULL) == INT_MAX && get_status() == INPUT_EOF);
+    destroy_stream(m);
+
+    // Time out standard input, locked for whole call
+    CHECK(dup2(fds[0], STDIN_FILENO) >= 0);
+    set_limits(NULL, 0, SIZE_MAX);
+    CHECK(get_char(NULL) == CHAR_MAX && get_status() == INPUT_TIMEOUT);
+    set_line_limit(NULL, SIZE_MAX, LINE_TRUNCATE);
+    CHECK(get_status() == INPUT_TIMEOUT);
+    CHECK(write(fds[1], "c\n", 2) == 2);
+    CHECK(get_char(NULL) == 'c' && get_status() == INPUT_OK);
+
+    destroy_stream(s);
+    fprintf(stderr, "limit-test: OK\n");
+    return 0;
+}
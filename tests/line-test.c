@@ -0,0 +1,263 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/stdprompt.h"
+
+// Define size of generated input and length of long lines
+#define INPUT_SIZE (1 << 20)
+#define LONG_LINE 200000
+
+void generate(unsigned long seed);
+int reference(void);
+int library(void);
+int batches(void);
+int releases(void);
+int views(void);
+int streams(const char *kind);
+
+int main(int argc, char const *argv[])
+{
+    if (argc == 3 && !strcmp(argv[1], "gen"))
+    {
+        generate(strtoul(argv[2], NULL, 10));
+        return 0;
+    }
+
+    if (argc == 2 && !strcmp(argv[1], "ref"))
+        return reference();
+
+    if (argc == 2 && !strcmp(argv[1], "lib"))
+        return library();
+
+    if (argc == 2 && !strcmp(argv[1], "arena"))
+        return batches();
+
+    if (argc == 2 && !strcmp(argv[1], "release"))
+        return releases();
+
+    if (argc == 2 && !strcmp(argv[1], "view"))
+        return views();
+
+    if (argc == 2 && (!strcmp(argv[1], "file") || !strcmp(argv[1], "fd") || !strcmp(argv[1], "memory") || !strcmp(argv[1], "callback")))
+        return streams(argv[1]);
+
+    fprintf(stderr, "\nUsage: %s gen <seed> | ref | lib | arena | release | view | file | fd | memory | callback\n", argv[0]);
+    fprintf(stderr, "Compare lines read by get_string against reference fgetc reader.\n\n");
+    return 1;
+}
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Write random lines with mixed CR (\r), LF (\n), and CRLF (\r\n) endings to standard output
+// Write in random chunk sizes so lines and CRLF pairs straddle reads on pipes
+void generate(unsigned long seed)
+{
+    static const char alphabet[] = "abc xyz 0123456789\t\v\f-+.e";
+    static const char *endings[] = {"\n", "\r", "\r\n", "\n\r", "\r\r"};
+
+    unsigned long state = seed;
+    char *data = malloc(INPUT_SIZE + LONG_LINE + 2);
+    if (data == NULL)
+        return;
+
+    size_t size = 0;
+    while (size < INPUT_SIZE)
+    {
+        // Mostly short lines, with rare lines longer than a read block
+        unsigned long kind = next(&state) % 100;
+        size_t n = kind == 0 && next(&state) % 10 == 0 ? LONG_LINE + next(&state) % 1000 : kind < 10 ? 0 : next(&state) % 120;
+
+        for (size_t i = 0; i < n; i++)
+            data[size++] = next(&state) % 50 == 0 ? '\0' : alphabet[next(&state) % (sizeof(alphabet) - 1)];
+
+        const char *ending = endings[next(&state) % 5];
+        memcpy(data + size, ending, strlen(ending));
+        size += strlen(ending);
+    }
+
+    // Leave last line unterminated for odd seeds
+    if (seed % 2)
+        data[size++] = 'z';
+
+    for (size_t i = 0; i < size;)
+    {
+        size_t n = 1 + next(&state) % 4096;
+        if (n > size - i)
+            n = size - i;
+        fwrite(data + i, 1, n, stdout);
+        i += n;
+    }
+
+    free(data);
+}
+
+// Read lines with original fgetc loop of get_string and print length and text
+int reference(void)
+{
+    while (true)
+    {
+        size_t capacity = 16, size = 0;
+        char *buffer = malloc(capacity);
+        int c;
+
+        while ((c = fgetc(stdin)) != '\r' && c != '\n' && c != EOF)
+        {
+            if (size + 1 > capacity)
+                buffer = realloc(buffer, capacity *= 2);
+            buffer[size++] = c;
+        }
+
+        if (size == 0 && c == EOF)
+        {
+            free(buffer);
+            return 0;
+        }
+
+        if (c == '\r')
+        {
+            int next = fgetc(stdin);
+            if (next != '\n' && next != EOF)
+                ungetc(next, stdin);
+        }
+
+        buffer = realloc(buffer, size + 1);
+        buffer[size] = '\0';
+        printf("%zu:%s\n", strlen(buffer), buffer);
+        free(buffer);
+    }
+}
+
+// Read lines with get_string and print length and text
+int library(void)
+{
+    char *str;
+    while ((str = get_string(NULL)) != NULL)
+        printf("%zu:%s\n", strlen(str), str);
+    return 0;
+}
+
+// Read batches of lines with get_string into arena, then print and reset each batch
+int batches(void)
+{
+    arena *a = create_arena();
+    if (a == NULL || use_arena(a) != NULL)
+        return 1;
+
+    char *batch[64];
+    size_t n;
+    do
+    {
+        for (n = 0; n < 64 && (batch[n] = get_string(NULL)) != NULL; n++)
+            ;
+
+        for (size_t i = 0; i < n; i++)
+            printf("%zu:%s\n", strlen(batch[i]), batch[i]);
+
+        reset_arena(a);
+    } while (n == 64);
+
+    destroy_arena(a);
+    return 0;
+}
+
+// Read batches of lines with get_string, freeing them with rollback_strings, free_string, or keep_strings in turn
+int releases(void)
+{
+    keep_strings(100);
+
+    char *batch[64];
+    size_t n;
+    for (size_t k = 0;; k++)
+    {
+        size_t mark = checkpoint_strings();
+
+        for (n = 0; n < 64 && (batch[n] = get_string(NULL)) != NULL; n++)
+            ;
+
+        for (size_t i = 0; i < n; i++)
+            printf("%zu:%s\n", strlen(batch[i]), batch[i]);
+
+        if (k % 3 == 0) // Free whole batch
+            rollback_strings(mark);
+        else if (k % 3 == 1) // Free every other string, leaving rest to keep_strings
+            for (size_t i = 0; i < n; i += 2)
+                free_string(batch[i]);
+
+        if (n < 64)
+            return 0;
+    }
+}
+
+// Read lines with get_line_view and print length and text up to first '\0' like reference reader
+int views(void)
+{
+    line_view line;
+    while ((line = get_line_view(NULL)).data != NULL)
+    {
+        const char *zero = memchr(line.data, '\0', line.size);
+        size_t n = zero != NULL ? (size_t)(zero - line.data) : line.size;
+
+        printf("%zu:", n);
+        fwrite(line.data, 1, n, stdout);
+        printf("\n");
+    }
+    return 0;
+}
+
+// Read up to 7 bytes of standard input at a time, so every line and CRLF pair straddles blocks
+static ptrdiff_t trickle(void *context, char *buffer, size_t capacity)
+{
+    unsigned long *state = context;
+    size_t n = 1 + next(state) % 7;
+    return read(STDIN_FILENO, buffer, n < capacity ? n : capacity);
+}
+
+// Read lines from stream of kind over standard input with get_string_from, or get_line_view_from for memory
+int streams(const char *kind)
+{
+    static char data[2 * (INPUT_SIZE + LONG_LINE + 2)];
+    unsigned long state = 1;
+    stream *s;
+
+    if (!strcmp(kind, "file"))
+        s = create_file_stream(stdin);
+    else if (!strcmp(kind, "fd"))
+        s = create_fd_stream(STDIN_FILENO);
+    else if (!strcmp(kind, "callback"))
+        s = create_callback_stream(trickle, &state);
+    else
+        s = create_memory_stream(data, fread(data, 1, sizeof(data), stdin));
+    if (s == NULL)
+        return 1;
+
+    if (!strcmp(kind, "memory"))
+    {
+        line_view line;
+        while ((line = get_line_view_from(s, NULL)).data != NULL)
+        {
+            const char *zero = memchr(line.data, '\0', line.size);
+            size_t n = zero != NULL ? (size_t)(zero - line.data) : line.size;
+
+            printf("%zu:", n);
+            fwrite(line.data, 1, n, stdout);
+            printf("\n");
+        }
+    }
+    else
+    {
+        char *str;
+        while ((str = get_string_from(s, NULL)) != NULL)
+            printf("%zu:%s\n", strlen(str), str);
+    }
+
+    destroy_stream(s);
+    return 0;
+}
@@ -0,0 +1,231 @@
+// Enable POSIX functions for pipes and redirecting standard input
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <float.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of lines, and number of digits in line longer than batch of streamed input
+#define LINES 300000
+#define LONG_LINE 5000000
+
+// Initialise generated text, and values and line numbers of rejected lines expected from get_double function
+static char *text;
+static size_t size;
+static double *expected;
+static size_t *rejected;
+static size_t lines, errors;
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Append line of random numeric syntax, valid or not, with random line ending
+static void line(FILE *file, unsigned long *state)
+{
+    static const char *edges[] = {
+        "", " ", "x", "1.5.5", "--1", "3e", ".e1", ".5", "5.", "1e400", "1e-400", "0x1p3", "inf", "nan",
+        "  -0 ", "+7", "1e-310", "12345678901234567890", "1 2", "4\0junk", "9007199254740993", "0.1",
+    };
+    static const char *endings[] = {"\n", "\r", "\r\n"};
+
+    unsigned long kind = next(state) % 5;
+    if (kind == 0)
+    {
+        const char *edge = edges[next(state) % (sizeof(edges) / sizeof(edges[0]))];
+        fwrite(edge, 1, strcmp(edge, "4") ? strlen(edge) : 6, file); // Write '\0' inside line
+    }
+    else
+    {
+        if (next(state) % 8 == 0)
+            fputc(' ', file);
+        if (next(state) % 3 == 0)
+            fputc("+-"[next(state) % 2], file);
+        for (size_t i = 1 + next(state) % 18; i > 0; i--)
+            fputc('0' + next(state) % 10, file);
+        if (kind >= 2)
+            fprintf(file, ".%lu", next(state) % 100000);
+        if (kind >= 3)
+            fprintf(file, "e%d", (int)(next(state) % 700) - 350);
+    }
+    fputs(endings[next(state) % 3], file);
+}
+
+// Generate lines, including line of digits longer than batch, and last line without line ending
+static bool generate(unsigned long seed)
+{
+    unsigned long state = seed;
+    FILE *file = open_memstream(&text, &size);
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        if (i == LINES / 2)
+        {
+            for (size_t j = 0; j < LONG_LINE; j++)
+                fputc('1', file);
+            fputs("\r\n", file);
+        }
+        line(file, &state);
+    }
+    fputs("2.5", file);
+    return fclose(file) == 0;
+}
+
+// Read each line with get_line_view_from function, then convert it with get_double_from function on its own stream
+static bool reference(void)
+{
+    expected = malloc((LINES + 2) * sizeof(double));
+    rejected = malloc((LINES + 2) * sizeof(size_t));
+    stream *s = create_memory_stream(text, size);
+    if (expected == NULL || rejected == NULL || s == NULL)
+        return false;
+
+    for (line_view view; (view = get_line_view_from(s, NULL)).data != NULL; lines++)
+    {
+        stream *one = create_memory_stream(view.data, view.size);
+        if (one == NULL)
+            return false;
+
+        // Rejected line makes get_double_from retry, reaching EOF of its stream
+        expected[lines] = view.size > 0 ? get_double_from(one, NULL) : DBL_MAX;
+        if (expected[lines] == DBL_MAX)
+            rejected[errors++] = lines + 1;
+        destroy_stream(one);
+    }
+
+    destroy_stream(s);
+    return true;
+}
+
+// Compare values and rejected lines from load_doubles function, skipping lines read before
+static bool compare(const char *mode, double *values, size_t count, size_t *lines_rejected, size_t number, size_t skipped)
+{
+    bool ok = values != NULL && count == lines - skipped;
+    for (size_t i = 0; ok && i < count; i++)
+        if (memcmp(&values[i], &expected[skipped + i], sizeof(double)))
+        {
+            fprintf(stderr, "load-test: %s: line %zu: got %.17g, expected %.17g\n", mode, i + 1, values[i], expected[skipped + i]);
+            ok = false;
+        }
+
+    size_t first = 0; // Index of first rejected line after skipped lines
+    while (first < errors && rejected[first] <= skipped)
+        first++;
+
+    ok = ok && number == errors - first;
+    for (size_t e = 0; ok && e < number; e++)
+        ok = lines_rejected[e] == rejected[first + e] - skipped;
+
+    if (!ok)
+        fprintf(stderr, "load-test: %s: got %zu lines and %zu rejected, expected %zu and %zu\n",
+                mode, count, number, lines - skipped, errors - first);
+    free(values);
+    free(lines_rejected);
+    return ok;
+}
+
+// Load every line of stream, or of standard input if stream is NULL, and compare results
+static bool check(const char *mode, stream *s, size_t threads, size_t skipped)
+{
+    size_t count, *lines_rejected, number;
+    double *values = load_doubles(s, &count, &lines_rejected, &number, threads);
+    bool ok = compare(mode, values, count, lines_rejected, number, skipped);
+    destroy_stream(s);
+    return ok;
+}
+
+// Write text into pipe in pieces of random size, so CRLF (\r\n) pairs straddle reads
+static void *writer(void *argument)
+{
+    int fd = *(int *)argument;
+    unsigned long state = 7;
+    for (size_t i = 0; i < size;)
+    {
+        size_t n = 1 + next(&state) % 9000;
+        ssize_t written = write(fd, text + i, n < size - i ? n : size - i);
+        if (written <= 0)
+            break;
+        i += (size_t)written;
+    }
+    close(fd);
+    return NULL;
+}
+
+// Return text in pieces of random size, as callback of stream
+static ptrdiff_t pieces(void *context, char *buffer, size_t capacity)
+{
+    size_t *offset = context;
+    size_t n = 1 + *offset * 2654435761u % 4096;
+    if (n > capacity)
+        n = capacity;
+    if (n > size - *offset)
+        n = size - *offset;
+    memcpy(buffer, text + *offset, n);
+    *offset += n;
+    return (ptrdiff_t)n;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <seed>\n", argv[0]);
+        fprintf(stderr, "Compare load_doubles function against get_double function on memory, files, pipes, and callbacks.\n\n");
+        return 1;
+    }
+
+    if (!generate(strtoul(argv[1], NULL, 10)) || !reference())
+        return 2;
+
+    // Parse bytes in memory on one thread, several threads, and one thread per processor
+    bool ok = check("memory, 1 thread", create_memory_stream(text, size), 1, 0) &&
+              check("memory, 3 threads", create_memory_stream(text, size), 3, 0) &&
+              check("memory, processors", create_memory_stream(text, size), 0, 0);
+
+    // Parse mapped file on standard input after line read by get_line_view function
+    FILE *file = tmpfile();
+    if (file == NULL || fwrite(text, 1, size, file) != size || fflush(file) || dup2(fileno(file), STDIN_FILENO) < 0)
+        return 2;
+    lseek(STDIN_FILENO, 0, SEEK_SET);
+    ok = ok && get_line_view(NULL).data != NULL && check("mapped file", NULL, 4, 1);
+
+    // Parse pipe in batches after line read by get_line_view_from function
+    int fds[2];
+    pthread_t id;
+    if (pipe(fds) || pthread_create(&id, NULL, writer, &fds[1]))
+        return 2;
+    stream *s = create_fd_stream(fds[0]);
+    ok = ok && get_line_view_from(s, NULL).data != NULL && check("pipe", s, 2, 1);
+    pthread_join(id, NULL);
+    close(fds[0]);
+
+    // Parse callback in batches
+    size_t offset = 0;
+    ok = ok && check("callback", create_callback_stream(pieces, &offset), 2, 0);
+
+    // Check no input
+    size_t count = 1, number = 1, *lines_rejected = NULL;
+    ok = ok && load_doubles(create_memory_stream("", 0), &count, &lines_rejected, &number, 2) == NULL && count == 0 && number == 0 &&
+         get_status() == INPUT_EOF;
+
+    // Tell allocation failure apart from no input, with too many threads to allocate their chunks
+    ok = ok && load_doubles(create_memory_stream("1\n", 2), &count, NULL, NULL, SIZE_MAX / 2) == NULL && count == 0 &&
+         get_status() == INPUT_ALLOC;
+
+    if (!ok)
+        return 3;
+    fprintf(stderr, "load-test: %zu lines, %zu rejected, matching get_double function\n", lines, errors);
+    free(text);
+    return 0;
+}
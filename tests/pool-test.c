@@ -0,0 +1,168 @@
+// Enable POSIX functions for memory streams
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of lines, lines kept alive at most, and lines read after warm-up without allocating
+#define LINES 200000
+#define KEPT 5000
+#define SHORT_LINES 100000
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                   \
+    if (!(condition))                                                      \
+    {                                                                      \
+        fprintf(stderr, "pool-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                          \
+    }
+
+// Count calls to allocator, wrapped at link time with -Wl,--wrap
+static size_t allocations = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocations++;
+    return __real_realloc(ptr, size);
+}
+
+// Initialise generated text, and start and length of each line in it
+static char *text;
+static size_t size;
+static size_t starts[LINES], lengths[LINES];
+
+// Define string kept alive, with index of its line
+typedef struct kept
+{
+    char *str;   // String from get_string_from function
+    size_t line; // Index of line
+} kept;
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Generate lines mostly around size of cell of pool, some longer, with LF or CRLF line endings
+static bool generate(unsigned long seed)
+{
+    unsigned long state = seed;
+    FILE *file = open_memstream(&text, &size);
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        starts[i] = ftell(file);
+        lengths[i] = next(&state) % 4 ? next(&state) % 30 : next(&state) % 200;
+        for (size_t j = 0; j < lengths[i]; j++)
+            fputc('!' + next(&state) % 94, file);
+        fputs(next(&state) % 2 ? "\n" : "\r\n", file);
+    }
+    return fclose(file) == 0;
+}
+
+// Check string against its generated line
+static bool same(kept k)
+{
+    return strlen(k.str) == lengths[k.line] && !memcmp(k.str, text + starts[k.line], lengths[k.line]);
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <seed>\n", argv[0]);
+        fprintf(stderr, "Check short strings in pool and long strings on heap across free_string and rollback_strings functions.\n\n");
+        return 1;
+    }
+
+    unsigned long state = strtoul(argv[1], NULL, 10);
+    if (!generate(state))
+        return 2;
+
+    // Keep random set of strings alive, freeing strings one by one, twice, or by rollback, and check every string kept
+    static kept live[KEPT];
+    size_t count = 0, mark = checkpoint_strings(), first = 0; // Indicate live strings, and mark of rollback with its first line
+    stream *s = create_memory_stream(text, size);
+    CHECK(s != NULL);
+    for (size_t i = 0; i < LINES; i++)
+    {
+        kept k = {get_string_from(s, NULL), i};
+        CHECK(k.str != NULL && same(k));
+        live[count++] = k;
+
+        unsigned long op = next(&state) % 100;
+        if (count == KEPT || op < 40) // Free random string, and short string in cell of pool sometimes twice
+        {
+            size_t j = next(&state) % count;
+            free_string(live[j].str);
+            if (op % 2 == 0 && lengths[live[j].line] <= 23)
+                free_string(live[j].str);
+            live[j] = live[--count];
+        }
+        else if (op == 99) // Free every string since mark
+        {
+            rollback_strings(mark);
+            for (size_t j = 0; j < count;)
+                if (live[j].line >= first)
+                    live[j] = live[--count];
+                else
+                    j++;
+            mark = checkpoint_strings();
+            first = i + 1;
+        }
+
+        if (i % 10000 == 0)
+            for (size_t j = 0; j < count; j++)
+                CHECK(same(live[j]));
+    }
+    CHECK(get_string_from(s, NULL) == NULL);
+    for (size_t j = 0; j < count; j++)
+        CHECK(same(live[j]));
+    destroy_stream(s);
+
+    // Read short lines freed one by one without allocating, once cells and registry pages are reused
+    static char lines[SHORT_LINES * 9];
+    for (size_t i = 0; i < SHORT_LINES; i++)
+        memcpy(lines + 9 * i, i % 2 ? "12345678\n" : "yes\r\n\n\n\n\n", 9);
+    rollback_strings(0);
+    s = create_memory_stream(lines, sizeof(lines));
+    CHECK(s != NULL);
+    size_t before = 0, read = 0;
+    for (char *str; (str = get_string_from(s, NULL)) != NULL; read++)
+    {
+        if (read == 10)
+            before = allocations;
+        CHECK(!strcmp(str, "12345678") || !strcmp(str, "yes") || !strcmp(str, ""));
+        free_string(str);
+    }
+    CHECK(allocations == before);
+    destroy_stream(s);
+
+    free(text);
+    fprintf(stderr, "pool-test: %d lines, %zu kept at end, %zu short lines without allocating\n", LINES, count, read - 10);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Enable POSIX functions for redirecting standard input and output, and for pipes
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "../src/stdprompt.h"
+
+// Define long argument, so rendered prompt outgrows its first buffer
+#define LONG_NAME "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz0123456789"
+
+// Redirect standard input to file of lines, and standard output to file returned for checking
+static FILE *redirect(const char *lines)
+{
+    FILE *in = tmpfile(), *out = tmpfile();
+    if (in == NULL || out == NULL)
+        return NULL;
+
+    fputs(lines, in);
+    fflush(in);
+    rewind(in);
+    if (dup2(fileno(in), STDIN_FILENO) < 0 || dup2(fileno(out), STDOUT_FILENO) < 0)
+        return NULL;
+    return out;
+}
+
+// Return number of bytes written to file of standard output, without flushing standard output
+static long long size(FILE *out)
+{
+    struct stat st;
+    return fstat(fileno(out), &st) == 0 ? (long long)st.st_size : -1;
+}
+
+// Compare everything written to standard output so far against expected text
+static bool written(FILE *out, const char *expected)
+{
+    static char text[4096];
+    fflush(stdout);
+    rewind(out);
+    size_t n = fread(text, 1, sizeof(text) - 1, out);
+    text[n] = '\0';
+
+    if (strcmp(text, expected))
+    {
+        fprintf(stderr, "prompt-test: got \"%s\", expected \"%s\"\n", text, expected);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    // Each value follows rejected lines, so typed functions write prompt again on retries
+    FILE *out = redirect("x\n\n4\n1e999\n2.5\nab\n c \n" "1 2\n3\n" "7\n" "8\n" "9\n");
+    if (out == NULL)
+        return 2;
+
+    int a = get_int("Value %d of %s: ", 1, LONG_NAME);
+    double b = get_double("%d%% done, %s> ", 50, "x");
+    char c = get_char("Plain prompt: ");
+    int d[3];
+    size_t count = 3;
+    get_int_array(d, &count, NULL, "Row %c: ", 'A');
+
+    if (a != 4 || b != 2.5 || c != 'c' || count != 3 || d[2] != 3)
+        return 3;
+    if (!written(out, "Value 1 of " LONG_NAME ": Value 1 of " LONG_NAME ": Value 1 of " LONG_NAME ": "
+                      "50% done, x> 50% done, x> " "Plain prompt: Plain prompt: " "Row A: "))
+        return 3;
+
+    // Skip prompts explicitly, and automatically since standard input is file
+    if (set_prompt_mode(PROMPT_SKIP) != PROMPT_SHOW || get_int("Skipped %d: ", 1) != 7)
+        return 3;
+    if (set_prompt_mode(PROMPT_AUTO) != PROMPT_SKIP || get_int("Skipped %d: ", 2) != 8)
+        return 3;
+    if (set_prompt_mode(PROMPT_SHOW) != PROMPT_SKIP || get_int("Shown %d: ", 3) != 9)
+        return 3;
+    if (!written(out, "Value 1 of " LONG_NAME ": Value 1 of " LONG_NAME ": Value 1 of " LONG_NAME ": "
+                      "50% done, x> 50% done, x> " "Plain prompt: Plain prompt: " "Row A: " "Shown 3: "))
+        return 3;
+
+    // Keep buffered output across reads of other streams, and flush it before read from standard input
+    int fds[2];
+    set_output_mode(OUTPUT_FULL);
+    if (pipe(fds) != 0 || write(fds[1], "5\n", 2) != 2)
+        return 3;
+    long long before = size(out);
+    printf("Pending");
+    stream *s = create_fd_stream(fds[0]);
+    if (s == NULL || get_int_from(s, NULL) != 5 || size(out) != before)
+        return 3;
+    if (get_int(NULL) != INT_MAX || size(out) != before + 7)
+        return 3;
+    destroy_stream(s);
+    close(fds[0]);
+    close(fds[1]);
+
+    fprintf(stderr, "prompt-test: OK\n");
+    return 0;
+}
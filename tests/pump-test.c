@@ -0,0 +1,203 @@
+// Enable POSIX functions for pipes and poll(2)
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of lines
+#define LINES 100000
+
+// Define lines and values emitted by pump
+typedef struct emitted
+{
+    size_t count;          // Number of lines emitted
+    size_t failed;         // Number of first line that differs from reference, from 1, or 0
+    stream *reference;     // Stream of same text, read by get_line_view_from function
+    pump_type type;        // Type of pump
+} emitted;
+
+// Initialise generated text
+static char *text;
+static size_t size;
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Generate lines of numbers, valid or not, with random line endings and last line without line ending
+static bool generate(unsigned long seed)
+{
+    static const char *edges[] = {"", " 12 ", "x", "-0", "1.5", "1e3", "4294967296", "-9223372036854775808", "7\0x"};
+    static const char *endings[] = {"\n", "\r", "\r\n"};
+
+    unsigned long state = seed;
+    FILE *file = open_memstream(&text, &size);
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        if (next(&state) % 4 == 0)
+        {
+            const char *edge = edges[next(&state) % (sizeof(edges) / sizeof(edges[0]))];
+            fwrite(edge, 1, strcmp(edge, "7") ? strlen(edge) : 3, file); // Write '\0' inside line
+        }
+        else
+            fprintf(file, "%ld", (long)(next(&state) % 2000000) - 1000000);
+        fputs(endings[next(&state) % 3], file);
+    }
+    fputs("123", file);
+    return fclose(file) == 0;
+}
+
+// Compare line and value emitted by pump against get_line_view_from and get_long_long_from functions
+static void collect(void *context, const void *value, line_view line)
+{
+    emitted *e = context;
+    e->count++;
+    if (e->failed != 0)
+        return;
+
+    line_view view = get_line_view_from(e->reference, NULL);
+    bool same = view.data != NULL && view.size == line.size && !memcmp(view.data, line.data, line.size);
+    if (same && e->type == PUMP_LONG_LONG)
+    {
+        // Rejected line makes get_long_long_from retry, reaching EOF of its stream
+        stream *one = create_memory_stream(view.data, view.size);
+        long long expected = view.size > 0 ? get_long_long_from(one, NULL) : LLONG_MAX;
+        destroy_stream(one);
+        same = value != NULL ? *(const long long *)value == expected : expected == LLONG_MAX;
+    }
+    else if (same)
+        same = value == NULL;
+
+    if (!same)
+        e->failed = e->count;
+}
+
+// Check lines emitted by pump against reference, after end of input
+static bool checked(const char *mode, emitted *e)
+{
+    if (e->failed == 0 && get_line_view_from(e->reference, NULL).data == NULL)
+        return true;
+
+    fprintf(stderr, "pump-test: %s: line %zu differs from reference, %zu lines emitted\n", mode, e->failed, e->count);
+    return false;
+}
+
+// Feed text to pump in pieces of random size, so lines and CRLF pairs straddle calls
+static bool feed(pump_type type, unsigned long seed)
+{
+    emitted e = {0, 0, create_memory_stream(text, size), type};
+    pump *p = create_pump(-1, type, collect, &e);
+    if (e.reference == NULL || p == NULL)
+        return false;
+
+    unsigned long state = seed;
+    for (size_t i = 0; i < size;)
+    {
+        size_t n = 1 + next(&state) % (next(&state) % 2 ? 3 : 200);
+        n = n < size - i ? n : size - i;
+        if (pump_bytes(p, text + i, n) < 0)
+            return false;
+        i += n;
+    }
+
+    bool ok = pump_bytes(p, NULL, 0) == 1 && pump_bytes(p, "1\n", 2) == -1; // Emit last line, then reject bytes
+    ok = ok && checked(type == PUMP_LINE ? "bytes, lines" : "bytes, long long", &e);
+    destroy_pump(p);
+    destroy_stream(e.reference);
+    return ok;
+}
+
+// Write text into pipe in pieces of random size
+static void *writer(void *argument)
+{
+    int fd = *(int *)argument;
+    unsigned long state = 11;
+    for (size_t i = 0; i < size;)
+    {
+        size_t n = 1 + next(&state) % 5000;
+        ssize_t written = write(fd, text + i, n < size - i ? n : size - i);
+        if (written <= 0)
+            break;
+        i += (size_t)written;
+    }
+    close(fd);
+    return NULL;
+}
+
+// Drive pump of pipe from poll(2) loop, like event loop serving other sources
+static bool loop(void)
+{
+    int fds[2];
+    if (pipe(fds))
+        return false;
+
+    emitted e = {0, 0, create_memory_stream(text, size), PUMP_LONG_LONG};
+    pump *p = create_pump(fds[0], PUMP_LONG_LONG, collect, &e);
+    if (e.reference == NULL || p == NULL)
+        return false;
+
+    // Check pump returns without blocking before any bytes are written
+    if (pump_input(p) != 0)
+        return false;
+
+    pthread_t id;
+    if (pthread_create(&id, NULL, writer, &fds[1]))
+        return false;
+
+    ptrdiff_t n = 0;
+    size_t calls = 0;
+    while (n >= 0)
+    {
+        struct pollfd ready = {.fd = fds[0], .events = POLLIN};
+        if (poll(&ready, 1, 1000) < 0)
+            return false;
+        n = pump_input(p);
+        calls++;
+    }
+
+    pthread_join(id, NULL);
+    close(fds[0]);
+    fprintf(stderr, "pump-test: pipe: %zu lines in %zu calls\n", e.count, calls);
+    bool ok = checked("pipe", &e);
+    destroy_pump(p);
+    destroy_stream(e.reference);
+    return ok;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <seed>\n", argv[0]);
+        fprintf(stderr, "Compare pumps fed in pieces and driven by poll(2) against get_line_view and get_long_long functions.\n\n");
+        return 1;
+    }
+
+    unsigned long seed = strtoul(argv[1], NULL, 10);
+    if (!generate(seed))
+        return 2;
+
+    if (!feed(PUMP_LINE, seed) || !feed(PUMP_LONG_LONG, seed) || !loop())
+        return 3;
+
+    // Leave pump for library destructor
+    create_pump(-1, PUMP_DOUBLE, collect, NULL);
+
+    free(text);
+    fprintf(stderr, "pump-test: OK\n");
+    return 0;
+}
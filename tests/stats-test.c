@@ -0,0 +1,300 @@
+// Enable POSIX functions for pipes, processes, and clocks
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of lines read by each thread, number of threads, strings kept to fill several registry pages, and threads started in turn
+#define THREAD_LINES 5000
+#define THREADS 4
+#define STRINGS 20000
+#define TURNS 500
+
+// Return bytes allocated on heap by every thread, counted by address sanitizer
+size_t __sanitizer_get_current_allocated_bytes(void);
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                    \
+    if (!(condition))                                                       \
+    {                                                                       \
+        fprintf(stderr, "stats-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                           \
+    }
+
+// Store difference between statistics now and earlier snapshot in delta, and take snapshot again
+static void since(input_stats *before, input_stats *delta)
+{
+    input_stats now;
+    get_stats(&now);
+    *delta = (input_stats){
+        .lines = now.lines - before->lines,
+        .bytes = now.bytes - before->bytes,
+        .reads = now.reads - before->reads,
+        .grows = now.grows - before->grows,
+        .strings = now.strings - before->strings,
+        .pages = now.pages - before->pages,
+        .expansions = now.expansions - before->expansions,
+        .read_ns = now.read_ns - before->read_ns,
+        .parse_ns = now.parse_ns - before->parse_ns,
+    };
+    for (size_t i = 0; i < STATS_GETTERS; i++)
+        delta->retries[i] = now.retries[i] - before->retries[i];
+    *before = now;
+}
+
+// Return text in pieces of at most 7 bytes, as callback of stream
+static ptrdiff_t pieces(void *context, char *buffer, size_t capacity)
+{
+    const char **text = context;
+    size_t n = strlen(*text);
+    if (n > 7)
+        n = 7;
+    if (n > capacity)
+        n = capacity;
+    memcpy(buffer, *text, n);
+    *text += n;
+    return (ptrdiff_t)n;
+}
+
+// Write line into pipe after 50 milliseconds, so reader blocks
+static void *late(void *argument)
+{
+    int fd = *(int *)argument;
+    struct timespec pause = {0, 50000000};
+    nanosleep(&pause, NULL);
+    if (write(fd, "42\n", 3) != 3)
+        return NULL;
+    return argument;
+}
+
+// Read every line of memory stream of thread as int
+static void *count_lines(void *argument)
+{
+    char *text = argument;
+    stream *s = create_memory_stream(text, strlen(text));
+    if (s == NULL)
+        return NULL;
+    size_t n = 0;
+    while (get_int_from(s, NULL) != INT_MAX)
+        n++;
+    destroy_stream(s);
+    return n == THREAD_LINES ? argument : NULL;
+}
+
+// Read string from memory stream in thread, kept after thread ends
+static void *keep_line(void *argument)
+{
+    stream *s = create_memory_stream("kept\n", 5);
+    if (s == NULL)
+        return NULL;
+    char *str = get_string_from(s, NULL);
+    destroy_stream(s);
+    return str;
+}
+
+// Read int and string freed again from memory stream of thread, leaving no string behind
+static void *read_and_free(void *argument)
+{
+    stream *s = create_memory_stream("5\nfive\n", 7);
+    if (s == NULL)
+        return NULL;
+    bool ok = get_int_from(s, NULL) == 5 && get_status() == INPUT_OK;
+    char *str = get_string_from(s, NULL);
+    ok = ok && str != NULL && !strcmp(str, "five");
+    free_string(str);
+    destroy_stream(s);
+    return ok ? argument : NULL;
+}
+
+// Ignore values emitted by pump
+static void ignore(void *context, const void *value, line_view line)
+{
+}
+
+int main(void)
+{
+    input_stats before, delta;
+    CHECK(get_stats(&before));
+
+    // Keep string of finished thread, and free it with string of main thread at exit of child process, whose main thread has no state before thread
+    pid_t pid = fork();
+    CHECK(pid >= 0);
+    if (pid == 0)
+    {
+        pthread_t keeper;
+        void *kept;
+        if (pthread_create(&keeper, NULL, keep_line, NULL) != 0 || pthread_join(keeper, &kept) != 0 || kept == NULL || strcmp(kept, "kept") != 0)
+            exit(3);
+        stream *m = create_memory_stream("main\n", 5);
+        if (m == NULL || get_string_from(m, NULL) == NULL)
+            exit(3);
+        exit(0);
+    }
+    int status;
+    CHECK(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    // Count lines, bytes of memory, and retries of rejected lines by getter
+    const char text[] = "x\n1\n2.5\n\n-3\nq\n";
+    stream *s = create_memory_stream(text, sizeof(text) - 1);
+    CHECK(s != NULL);
+    CHECK(get_int_from(s, NULL) == 1);
+    CHECK(get_long_from(s, NULL) == -3);
+    CHECK(get_char_from(s, NULL) == 'q');
+    destroy_stream(s);
+    since(&before, &delta);
+    CHECK(delta.lines == 6 && delta.bytes == sizeof(text) - 1 && delta.reads == 0);
+    CHECK(delta.retries[STATS_INT] == 1 && delta.retries[STATS_LONG] == 2 && delta.retries[STATS_CHAR] == 0);
+
+    // Count reads of callback, growth of string buffer, and strings kept in registry
+    char line[101];
+    memset(line, 'a', 100);
+    line[100] = '\0';
+    char data[256];
+    snprintf(data, sizeof(data), "%s\nab\n", line);
+    const char *cursor = data;
+    input_stats start = before;
+    s = create_callback_stream(pieces, &cursor);
+    CHECK(s != NULL);
+    char *str = get_string_from(s, NULL);
+    CHECK(str != NULL && !strcmp(str, line));
+    since(&before, &delta);
+    CHECK(delta.lines == 1 && delta.grows == 2 && delta.strings == 1); // Grow from 32 to 64 and 128 characters
+    str = get_string_from(s, NULL);
+    CHECK(str != NULL && !strcmp(str, "ab"));
+    CHECK(get_string_from(s, NULL) == NULL);
+    since(&before, &delta);
+    CHECK(delta.lines == 1 && delta.grows == 0 && delta.strings == 1);
+    since(&start, &delta);
+    CHECK(delta.bytes == strlen(data) && delta.reads == (strlen(data) + 6) / 7 + 1); // Count read returning EOF
+    free_string(str);
+    since(&before, &delta);
+    CHECK(delta.strings == (size_t)-1);
+    destroy_stream(s);
+
+    // Size first buffer of string from recent strings of stream, so repeated long lines grow it only once
+    static char repeated[1000 * 101 + 1];
+    for (size_t i = 0; i < 1000; i++)
+    {
+        memset(repeated + 101 * i, 'b', 100);
+        repeated[101 * i + 100] = '\n';
+    }
+    cursor = repeated;
+    s = create_callback_stream(pieces, &cursor);
+    CHECK(s != NULL);
+    while ((str = get_string_from(s, NULL)) != NULL)
+        free_string(str);
+    destroy_stream(s);
+    since(&before, &delta);
+    CHECK(delta.lines == 1000 && delta.grows == 2 && delta.strings == 0);
+
+    // Count pages and directory growth of registry, and strings freed by rollback
+    static char lines[2 * STRINGS];
+    for (size_t i = 0; i < STRINGS; i++)
+        memcpy(lines + 2 * i, "z\n", 2);
+    size_t mark = checkpoint_strings();
+    s = create_memory_stream(lines, sizeof(lines));
+    CHECK(s != NULL);
+    for (size_t i = 0; i < STRINGS; i++)
+        CHECK(get_string_from(s, NULL) != NULL);
+    destroy_stream(s);
+    since(&before, &delta);
+    CHECK(delta.strings == STRINGS && delta.pages >= STRINGS / 1024 && delta.expansions >= 1);
+    rollback_strings(mark);
+    since(&before, &delta);
+    CHECK(delta.strings == (size_t)-STRINGS);
+
+    // Count time blocked in read of pipe apart from parsing
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    s = create_fd_stream(fds[0]);
+    CHECK(s != NULL);
+    pthread_t writer;
+    CHECK(pthread_create(&writer, NULL, late, &fds[1]) == 0);
+    CHECK(get_int_from(s, NULL) == 42);
+    void *result;
+    CHECK(pthread_join(writer, &result) == 0 && result != NULL);
+    since(&before, &delta);
+    CHECK(delta.reads == 1 && delta.bytes == 3 && delta.read_ns >= 40000000 && delta.parse_ns < delta.read_ns);
+    destroy_stream(s);
+    close(fds[0]);
+    close(fds[1]);
+
+    // Sum lines of every thread, including threads already finished
+    static char texts[THREADS][THREAD_LINES * 8];
+    pthread_t ids[THREADS];
+    for (size_t t = 0; t < THREADS; t++)
+    {
+        char *p = texts[t];
+        for (size_t i = 0; i < THREAD_LINES; i++)
+            p += sprintf(p, "%zu\n", i * t);
+        CHECK(pthread_create(&ids[t], NULL, count_lines, texts[t]) == 0);
+    }
+    for (size_t t = 0; t < THREADS; t++)
+        CHECK(pthread_join(ids[t], &result) == 0 && result != NULL);
+    since(&before, &delta);
+    CHECK(delta.lines == THREADS * THREAD_LINES && delta.parse_ns > 0);
+
+    // Free state of each finished thread, keeping its counters, so threads started in turn keep memory bounded
+    size_t allocated = __sanitizer_get_current_allocated_bytes();
+    for (size_t t = 0; t < TURNS; t++)
+    {
+        pthread_t turn;
+        CHECK(pthread_create(&turn, NULL, read_and_free, &before) == 0);
+        CHECK(pthread_join(turn, &result) == 0 && result != NULL);
+    }
+    size_t grown = __sanitizer_get_current_allocated_bytes() - allocated;
+    since(&before, &delta);
+    CHECK(delta.lines == 2 * TURNS && delta.strings == 0 && delta.reads == 0);
+    CHECK((ptrdiff_t)grown < 16384);
+
+    // Count lines and bytes fed to pump, and lines loaded in bulk
+    pump *p = create_pump(-1, PUMP_DOUBLE, ignore, NULL);
+    CHECK(p != NULL);
+    CHECK(pump_bytes(p, "1\n2\n3", 5) == 2 && pump_bytes(p, NULL, 0) == 1);
+    destroy_pump(p);
+    s = create_memory_stream("1\n2\nx\n", 6);
+    CHECK(s != NULL);
+    size_t count;
+    double *values = load_doubles(s, &count, NULL, NULL, 2);
+    CHECK(values != NULL && count == 3);
+    free(values);
+    destroy_stream(s);
+    since(&before, &delta);
+    CHECK(delta.lines == 6 && delta.bytes == 11);
+
+    // Write statistics at exit of child process
+    CHECK(pipe(fds) == 0);
+    pid = fork();
+    CHECK(pid >= 0);
+    if (pid == 0)
+    {
+        close(fds[0]);
+        set_stats_dump(fdopen(fds[1], "w"));
+        s = create_memory_stream("y\n7\n", 4);
+        get_unsigned_int_from(s, NULL);
+        exit(0);
+    }
+    close(fds[1]);
+    char dump[4096];
+    size_t size = 0;
+    ssize_t n;
+    while ((n = read(fds[0], dump + size, sizeof(dump) - 1 - size)) > 0)
+        size += (size_t)n;
+    dump[size] = '\0';
+    close(fds[0]);
+    CHECK(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    CHECK(strstr(dump, "stdprompt: retries get_unsigned_int 1\n") != NULL && strstr(dump, "stdprompt: parse_ms ") != NULL);
+
+    get_stats(&before);
+    fprintf(stderr, "stats-test: %zu lines, %zu bytes, %zu reads, %.3f ms reading, %.3f ms parsing\n",
+            before.lines, before.bytes, before.reads, before.read_ns / 1e6, before.parse_ns / 1e6);
+    return 0;
+}
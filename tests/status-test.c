@@ -0,0 +1,278 @@
+// Enable POSIX functions for memory streams
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <limits.h>
+#include <float.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of random lines
+#define LINES 100000
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                     \
+    if (!(condition))                                                        \
+    {                                                                        \
+        fprintf(stderr, "status-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                            \
+    }
+
+// Define types checked against reference
+typedef enum kind
+{
+    INT,
+    UNSIGNED_INT,
+    LONG_LONG,
+    UNSIGNED_LONG_LONG,
+    FLOAT,
+    DOUBLE,
+    CHAR
+} kind;
+
+// Initialise generated text and its lines, ending at first '\0' like typed functions
+static char *text;
+static size_t size;
+static char *lines[LINES];
+
+// Return pseudo-random number from linear congruential generator
+static unsigned long next(unsigned long *state)
+{
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return *state >> 33;
+}
+
+// Generate lines of numbers near limits of types, valid or not, one per line
+static bool generate(unsigned long seed)
+{
+    static const char *edges[] = {
+        "", " ", "x", "+", "-", "-0", "+7", " 12 ", "1 2", "0x10", "2147483647", "2147483648", "-2147483648",
+        "-2147483649", "4294967295", "4294967296", "-1", "9223372036854775807", "9223372036854775808",
+        "-9223372036854775809", "18446744073709551615", "18446744073709551616", "000000000000000000000000001",
+        "123456789012345678901x", "1e400", "-1e400", "1e-400", "1e-310", "inf", "nan", "-inf", "1.5", "3.4e38",
+        "3.5e38", "1.5.5", "c", " c ", "cc", "\t",
+    };
+
+    unsigned long state = seed;
+    FILE *file = open_memstream(&text, &size);
+    if (file == NULL)
+        return false;
+
+    for (size_t i = 0; i < LINES; i++)
+    {
+        if (next(&state) % 4 == 0)
+            fputs(edges[next(&state) % (sizeof(edges) / sizeof(edges[0]))], file);
+        else
+        {
+            if (next(&state) % 3 == 0)
+                fputc("+- "[next(&state) % 3], file);
+            for (size_t n = 1 + next(&state) % 24; n > 0; n--)
+                fputc('0' + next(&state) % 10, file);
+            if (next(&state) % 8 == 0)
+                fputs((const char *[]){".5", "e39", "e-39", "x", " "}[next(&state) % 5], file);
+        }
+        fputc('\n', file);
+    }
+    if (fclose(file))
+        return false;
+
+    char *line = malloc(size + 1); // Split copy of text, leaving text for streams
+    if (line == NULL)
+        return false;
+    memcpy(line, text, size + 1);
+    for (size_t i = 0; i < LINES; i++)
+    {
+        lines[i] = line;
+        line = strchr(line, '\n');
+        *line++ = '\0';
+    }
+    return true;
+}
+
+// Classify line like library with strtoll(3) family, storing value if valid
+static input_status reference(kind k, const char *str, long double *value)
+{
+    const char *line = str;
+    while (isspace((unsigned char)*str)) // Trim leading whitespace
+        str++;
+
+    size_t n = strlen(str);
+    while (n > 0 && isspace((unsigned char)str[n - 1])) // Trim trailing whitespace
+        n--;
+
+    char copy[64];
+    if (n >= sizeof(copy))
+        n = sizeof(copy) - 1;
+    memcpy(copy, str, n);
+    copy[n] = '\0';
+
+    if (k == CHAR)
+    {
+        if (strlen(line) == 1) // Accept single char
+            *value = *line;
+        else if (n == 1) // Accept single char, trimming whitespace around it
+            *value = *copy;
+        else
+            return INPUT_SYNTAX;
+        return INPUT_OK;
+    }
+
+    if (n == 0 || ((k <= UNSIGNED_LONG_LONG) && !isdigit((unsigned char)copy[copy[0] == '+' || copy[0] == '-'])))
+        return INPUT_SYNTAX;
+
+    errno = 0;
+    char *end;
+    long double val;
+    if (k == FLOAT)
+        val = strtof(copy, &end);
+    else if (k == DOUBLE)
+        val = strtod(copy, &end);
+    else if (k == INT || k == LONG_LONG)
+        val = strtoll(copy, &end, 10);
+    else
+        val = strtoull(copy, &end, 10);
+
+    if (*end != '\0' || (errno == 0 && !isfinite(val)))
+        return INPUT_SYNTAX;
+    if (errno != 0 || ((k == UNSIGNED_INT || k == UNSIGNED_LONG_LONG) && *copy == '-'))
+        return INPUT_RANGE;
+
+    static const long double low[] = {INT_MIN, 0, LLONG_MIN, 0, -FLT_MAX, -DBL_MAX};
+    static const long double high[] = {INT_MAX, UINT_MAX, LLONG_MAX, ULLONG_MAX, FLT_MAX, DBL_MAX};
+    if (val < low[k] || val > high[k])
+        return INPUT_RANGE;
+
+    *value = val;
+    return INPUT_OK;
+}
+
+// Read every line once with try_get function of type and compare status and value against reference
+static bool compare(kind k, const char *name)
+{
+    stream *s = create_memory_stream(text, size);
+    if (s == NULL)
+        return false;
+
+    size_t counts[INPUT_SYNTAX + 1] = {0};
+    for (size_t i = 0; i < LINES; i++)
+    {
+        union
+        {
+            int i;
+            unsigned int ui;
+            long long ll;
+            unsigned long long ull;
+            float f;
+            double d;
+            char c;
+        } got;
+        memset(&got, 0xa5, sizeof(got));
+        unsigned char before[sizeof(got)];
+        memcpy(before, &got, sizeof(got));
+
+        input_status status;
+        long double value = 0;
+        switch (k)
+        {
+        case INT:
+            status = try_get_int(s, &got.i, NULL);
+            value = got.i;
+            break;
+        case UNSIGNED_INT:
+            status = try_get_unsigned_int(s, &got.ui, NULL);
+            value = got.ui;
+            break;
+        case LONG_LONG:
+            status = try_get_long_long(s, &got.ll, NULL);
+            value = got.ll;
+            break;
+        case UNSIGNED_LONG_LONG:
+            status = try_get_unsigned_long_long(s, &got.ull, NULL);
+            value = got.ull;
+            break;
+        case FLOAT:
+            status = try_get_float(s, &got.f, NULL);
+            value = got.f;
+            break;
+        case DOUBLE:
+            status = try_get_double(s, &got.d, NULL);
+            value = got.d;
+            break;
+        default:
+            status = try_get_char(s, &got.c, NULL);
+            value = got.c;
+            break;
+        }
+
+        long double expected = 0;
+        input_status wanted = reference(k, lines[i], &expected);
+        bool same = status == wanted && get_status() == status;
+        same = same && (status == INPUT_OK ? value == expected : !memcmp(before, &got, sizeof(got))); // Keep value on failure
+        if (!same)
+        {
+            fprintf(stderr, "status-test: %s: line %zu \"%s\": got %d, expected %d\n", name, i + 1, lines[i], status, wanted);
+            destroy_stream(s);
+            return false;
+        }
+        counts[status]++;
+    }
+
+    int eof = 42;
+    bool ok = try_get_int(s, &eof, NULL) == INPUT_EOF && eof == 42 && get_status() == INPUT_EOF;
+    destroy_stream(s);
+    fprintf(stderr, "status-test: %-7s %zu ok, %zu range, %zu syntax\n", name, counts[INPUT_OK], counts[INPUT_RANGE], counts[INPUT_SYNTAX]);
+    return ok;
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "\nUsage: %s <seed>\n", argv[0]);
+        fprintf(stderr, "Compare status of try_get functions against strtol(3) and strtod(3) families on random lines.\n\n");
+        return 1;
+    }
+
+    if (!generate(strtoul(argv[1], NULL, 10)))
+        return 2;
+
+    CHECK(compare(INT, "int") && compare(UNSIGNED_INT, "uint") && compare(LONG_LONG, "llong") &&
+          compare(UNSIGNED_LONG_LONG, "ullong") && compare(FLOAT, "float") && compare(DOUBLE, "double") &&
+          compare(CHAR, "char"));
+
+    // Tell genuine INT_MAX from sentinel value, and read rest of line types once
+    static const char input[] = "2147483647\nx\n7\n-1\n1e99999\nnan\nword\n";
+    stream *s = create_memory_stream(input, sizeof(input) - 1);
+    CHECK(s != NULL);
+    int i = 0;
+    CHECK(try_get_int(s, &i, NULL) == INPUT_OK && i == INT_MAX && get_status() == INPUT_OK);
+    CHECK(try_get_int(s, &i, NULL) == INPUT_SYNTAX && i == INT_MAX && get_status() == INPUT_SYNTAX);
+    CHECK(get_int_from(s, NULL) == 7 && get_status() == INPUT_OK);
+    unsigned long ul = 5;
+    CHECK(try_get_unsigned_long(s, &ul, NULL) == INPUT_RANGE && ul == 5);
+    long double ld = 5;
+    CHECK(try_get_long_double(s, &ld, NULL) == INPUT_RANGE && ld == 5);
+    CHECK(try_get_long_double(s, &ld, NULL) == INPUT_SYNTAX && ld == 5);
+    char *str = NULL;
+    CHECK(try_get_string(s, &str, NULL) == INPUT_OK && str != NULL && !strcmp(str, "word"));
+    CHECK(try_get_string(s, &str, NULL) == INPUT_EOF && !strcmp(str, "word") && get_status() == INPUT_EOF);
+    destroy_stream(s);
+
+    // Report success after rejected lines retried by typed functions
+    static const char retried[] = "x\n99999999999\n-3\n";
+    s = create_memory_stream(retried, sizeof(retried) - 1);
+    CHECK(s != NULL);
+    CHECK(get_int_from(s, NULL) == -3 && get_status() == INPUT_OK);
+    destroy_stream(s);
+
+    free(lines[0]);
+    free(text);
+    fprintf(stderr, "status-test: OK\n");
+    return 0;
+}
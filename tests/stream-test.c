@@ -0,0 +1,103 @@
+// Enable POSIX functions for redirecting standard input
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/stdprompt.h"
+
+// Report failed check with its line and stop test
+#define CHECK(condition)                                                     \
+    if (!(condition))                                                        \
+    {                                                                        \
+        fprintf(stderr, "stream-test: line %d: %s\n", __LINE__, #condition); \
+        return 3;                                                            \
+    }
+
+// Return bytes of text in chunks of 2 bytes, as callback of stream
+static ptrdiff_t chunks(void *context, char *buffer, size_t capacity)
+{
+    const char **text = context;
+    size_t n = strnlen(*text, 2);
+    memcpy(buffer, *text, n);
+    *text += n;
+    return (ptrdiff_t)n;
+}
+
+int main(void)
+{
+    // Redirect standard input to file, read through NULL stream
+    FILE *in = tmpfile();
+    if (in == NULL)
+        return 2;
+    fputs("42\n", in);
+    rewind(in);
+    if (dup2(fileno(in), STDIN_FILENO) < 0)
+        return 2;
+
+    // Interleave two memory streams, each keeping its own CR of CRLF pair and rest of line
+    static const char first[] = "1\r\n2\r\n 3.5 \r\n", second[] = "a\rb\r\n7, 8\n9\n";
+    stream *a = create_memory_stream(first, sizeof(first) - 1);
+    stream *b = create_memory_stream(second, sizeof(second) - 1);
+    CHECK(a != NULL && b != NULL);
+
+    CHECK(get_int_from(a, NULL) == 1);
+    CHECK(get_char_from(b, NULL) == 'a');
+    CHECK(get_long_from(a, NULL) == 2);
+    CHECK(get_char_from(b, NULL) == 'b');
+    CHECK(get_double_from(a, NULL) == 3.5);
+    int values[3];
+    size_t count = 3;
+    bool valid[3];
+    CHECK(get_int_array_from(b, values, &count, valid, NULL) == values && count == 3 && values[2] == 9);
+    CHECK(get_string_from(a, NULL) == NULL && get_int_from(b, NULL) == INT_MAX); // Both streams at EOF
+    destroy_stream(a);
+    destroy_stream(b);
+
+    // Read FILE stream up to end of line, leaving next line to caller
+    FILE *file = tmpfile();
+    CHECK(file != NULL);
+    fputs("first\r\nsecond\nthird\n", file);
+    rewind(file);
+    stream *f = create_file_stream(file);
+    CHECK(f != NULL);
+    char *str = get_string_from(f, NULL), line[16];
+    CHECK(str != NULL && !strcmp(str, "first"));
+    CHECK(fgets(line, sizeof(line), file) != NULL && !strcmp(line, "second\n"));
+    line_view view = get_line_view_from(f, NULL);
+    CHECK(view.size == 5 && !memcmp(view.data, "third", 5));
+    destroy_stream(f);
+
+    // Read FILE stream with CR (\r) line endings up to end of each line too
+    fclose(file);
+    file = tmpfile();
+    CHECK(file != NULL);
+    fputs("alpha\rbeta\rgamma\r\rdelta", file);
+    rewind(file);
+    f = create_file_stream(file);
+    CHECK(f != NULL);
+    str = get_string_from(f, NULL);
+    CHECK(str != NULL && !strcmp(str, "alpha"));
+    CHECK(fread(line, 1, 5, file) == 5 && !memcmp(line, "beta\r", 5));
+    str = get_string_from(f, NULL);
+    CHECK(str != NULL && !strcmp(str, "gamma"));
+    str = get_string_from(f, NULL);
+    CHECK(str != NULL && !strcmp(str, ""));
+    CHECK(fgets(line, sizeof(line), file) != NULL && !strcmp(line, "delta"));
+    destroy_stream(f);
+
+    // Read callback stream with values straddling chunks, and standard input through NULL stream
+    const char *text = "12345\r\n-6\r";
+    stream *c = create_callback_stream(chunks, &text);
+    CHECK(c != NULL);
+    CHECK(get_unsigned_long_long_from(c, NULL) == 12345 && get_long_long_from(c, NULL) == -6);
+    CHECK(get_line_view_from(c, NULL).data == NULL);
+    CHECK(get_int_from(NULL, NULL) == 42);
+    // Leave callback stream for library destructor
+
+    fprintf(stderr, "stream-test: OK\n");
+    return 0;
+}
@@ -0,0 +1,207 @@
+// Enable POSIX functions for redirecting standard input and for clocks
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "../src/stdprompt.h"
+
+// Define number of records read by each thread, maximum number of threads, and number of values on standard input
+#define RECORDS 20000
+#define THREADS 8
+#define SHARED 100000
+
+// Define runs of each thread count, and speedup of 2 threads over 1 thread required on several processors
+#define RUNS 3
+#define SCALING 1.3
+
+// Define work of each thread, reading records from its own memory stream
+typedef struct work
+{
+    size_t id;      // Number of thread
+    char *text;     // Records of thread
+    bool in_arena;  // Allocate strings of thread in its own arena
+    bool ok;        // Indicate every record matched
+} work;
+
+// Define work of threads sharing standard input
+typedef struct share
+{
+    long long sum; // Sum of values read by thread
+    size_t count;  // Number of values read by thread
+} share;
+
+// Return monotonic time in seconds
+static double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Return records of thread: number, word, and row of three numbers, with line endings varying by thread
+static char *generate(size_t id)
+{
+    static const char *endings[] = {"\n", "\r", "\r\n"};
+
+    size_t size = RECORDS * 64;
+    char *text = malloc(size), *end = text;
+    if (text == NULL)
+        return NULL;
+
+    const char *ending = endings[id % 3];
+    for (size_t i = 0; i < RECORDS; i++)
+        end += sprintf(end, "%zu%sword%zu-%zu%s%zu, %zu %zu%s", i, ending, id, i, ending, i, i + 1, i + 2, ending);
+    return text;
+}
+
+// Read every record of thread, checking values, strings kept and rolled back, and arrays
+static void *run(void *argument)
+{
+    work *w = argument;
+    w->ok = false;
+
+    stream *s = create_memory_stream(w->text, strlen(w->text));
+    arena *a = w->in_arena ? create_arena() : NULL;
+    if (s == NULL || (w->in_arena && a == NULL))
+        return NULL;
+    use_arena(a);
+
+    size_t mark = checkpoint_strings();
+    for (size_t i = 0; i < RECORDS; i++)
+    {
+        char expected[64];
+        sprintf(expected, "word%zu-%zu", w->id, i);
+
+        int value = get_int_from(s, "Value %zu: ", i);
+        char *str = get_string_from(s, NULL);
+        long row[3];
+        size_t count = 3;
+        if (value != (int)i || str == NULL || strcmp(str, expected) ||
+            get_long_array_from(s, row, &count, NULL, NULL) != row || count != 3 || row[2] != (long)i + 2)
+            return NULL;
+
+        if (i % 1000 == 999) // Free strings of thread in batches
+        {
+            if (a != NULL)
+                reset_arena(a);
+            else
+                rollback_strings(mark);
+        }
+    }
+
+    w->ok = get_int_from(s, NULL) == INT_MAX && use_arena(NULL) == a; // Check EOF, and arena still in use by thread
+    destroy_stream(s);
+    destroy_arena(a);
+    return NULL;
+}
+
+// Read values from standard input until EOF, shared with other threads
+static void *drain(void *argument)
+{
+    share *sh = argument;
+    for (int value; (value = get_int(NULL)) != INT_MAX; sh->count++)
+        sh->sum += value;
+    return NULL;
+}
+
+// Run threads, each with its own memory stream
+// Return false if any record did not match
+static bool spawn(work *works, size_t threads)
+{
+    pthread_t ids[THREADS];
+    for (size_t t = 0; t < threads; t++)
+        if (pthread_create(&ids[t], NULL, run, &works[t]))
+            return false;
+
+    bool ok = true;
+    for (size_t t = 0; t < threads; t++)
+    {
+        pthread_join(ids[t], NULL);
+        ok = ok && works[t].ok;
+    }
+    return ok;
+}
+
+int main(void)
+{
+    // Write values on standard input, shared by every thread
+    FILE *in = tmpfile();
+    if (in == NULL)
+        return 2;
+    for (size_t i = 0; i < SHARED; i++)
+        fprintf(in, "%zu\n", i % 1000);
+    fflush(in);
+    rewind(in);
+    if (dup2(fileno(in), STDIN_FILENO) < 0)
+        return 2;
+
+    work works[THREADS];
+    for (size_t t = 0; t < THREADS; t++)
+    {
+        works[t] = (work){t, generate(t), t % 2 == 1, false};
+        if (works[t].text == NULL)
+            return 2;
+    }
+
+    // Read each value on standard input exactly once across threads
+    pthread_t ids[THREADS / 2];
+    share shares[THREADS / 2] = {{0, 0}};
+    for (size_t t = 0; t < THREADS / 2; t++)
+        if (pthread_create(&ids[t], NULL, drain, &shares[t]))
+            return 2;
+
+    long long sum = 0;
+    size_t count = 0;
+    for (size_t t = 0; t < THREADS / 2; t++)
+    {
+        pthread_join(ids[t], NULL);
+        sum += shares[t].sum;
+        count += shares[t].count;
+    }
+    if (count != SHARED || sum != (long long)SHARED / 1000 * (999 * 1000 / 2))
+    {
+        fprintf(stderr, "thread-test: read %zu values from standard input, expected %d\n", count, SHARED);
+        return 3;
+    }
+
+    // Report throughput of threads with their own streams, keeping best of several runs for each thread count
+    double rates[THREADS + 1] = {0};
+    for (size_t threads = 1; threads <= THREADS; threads *= 2)
+    {
+        for (size_t run = 0; run < RUNS; run++)
+        {
+            double start = now();
+            if (!spawn(works, threads))
+            {
+                fprintf(stderr, "thread-test: records differ with %zu threads\n", threads);
+                return 3;
+            }
+            double rate = threads * RECORDS / (now() - start);
+            if (rate > rates[threads])
+                rates[threads] = rate;
+        }
+        fprintf(stderr, "thread-test: %zu threads, %.0f records/s\n", threads, rates[threads]);
+    }
+
+    // Check threads with their own streams scale, only with processors to run them on
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors > 1 && rates[2] < SCALING * rates[1])
+    {
+        fprintf(stderr, "thread-test: 2 threads reach %.2f times throughput of 1 thread on %ld processors, expected %.2f\n",
+                rates[2] / rates[1], processors, SCALING);
+        return 3;
+    }
+    if (processors <= 1)
+        fprintf(stderr, "thread-test: scaling not checked on 1 processor\n");
+
+    for (size_t t = 0; t < THREADS; t++)
+        free(works[t].text);
+    fprintf(stderr, "thread-test: OK\n");
+    return 0;
+}